@@ -0,0 +1,140 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+
+
+#include "AllocationCounter.h"
+#include <cstdlib>
+#include <new>
+
+// glibc's own allocation functions, which the replacements of malloc call
+#if JUCE_LINUX && defined (__GLIBC__)
+ #define CIELCH_REPLACE_MALLOC 1
+
+ extern "C" void* __libc_malloc(size_t size);
+ extern "C" void* __libc_calloc(size_t numElements, size_t size);
+ extern "C" void* __libc_realloc(void* block, size_t size);
+#else
+ #define CIELCH_REPLACE_MALLOC 0
+#endif
+
+namespace
+{
+    // plain ints, so that using them never allocates
+    thread_local int numActiveCounters = 0;
+    thread_local int numAllocations = 0;
+
+    void countAllocation() noexcept
+    {
+        if (numActiveCounters > 0)
+            ++numAllocations;
+    }
+
+    void* allocate(size_t size) noexcept
+    {
+       #if CIELCH_REPLACE_MALLOC
+        return __libc_malloc(size == 0 ? 1 : size);
+       #else
+        return std::malloc(size == 0 ? 1 : size);
+       #endif
+    }
+}
+
+//==============================================================================
+AllocationCounter::AllocationCounter() noexcept
+    : startCount(numAllocations)
+{
+    ++numActiveCounters;
+}
+
+AllocationCounter::~AllocationCounter() noexcept
+{
+    --numActiveCounters;
+}
+
+int AllocationCounter::getNumAllocations() const noexcept
+{
+    return numAllocations - startCount;
+}
+
+//==============================================================================
+void* operator new(size_t size)
+{
+    countAllocation();
+
+    if (void* block = allocate(size))
+        return block;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    countAllocation();
+
+    if (void* block = allocate(size))
+        return block;
+
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept      { countAllocation(); return allocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept    { countAllocation(); return allocate(size); }
+
+void operator delete(void* block) noexcept                           { std::free(block); }
+void operator delete[](void* block) noexcept                         { std::free(block); }
+void operator delete(void* block, size_t) noexcept                   { std::free(block); }
+void operator delete[](void* block, size_t) noexcept                 { std::free(block); }
+void operator delete(void* block, const std::nothrow_t&) noexcept    { std::free(block); }
+void operator delete[](void* block, const std::nothrow_t&) noexcept  { std::free(block); }
+
+#if CIELCH_REPLACE_MALLOC
+extern "C" void* malloc(size_t size)
+{
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t numElements, size_t size)
+{
+    countAllocation();
+    return __libc_calloc(numElements, size);
+}
+
+extern "C" void* realloc(void* block, size_t size)
+{
+    countAllocation();
+    return __libc_realloc(block, size);
+}
+#endif
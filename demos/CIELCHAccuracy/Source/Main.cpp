@@ -0,0 +1,651 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "AllocationCounter.h"
+#include <functional>
+#include <iostream>
+#include <vector>
+
+/*
+Sends every 24-bit sRGB colour through RGBtoCIELCH and back through CIELCHtoRGB, for every
+precision and instruction set, and checks the results against the exact conversion.
+
+Usage: CIELCHAccuracy [--output results.json]
+
+--output    also writes the results as JSON to a file
+
+For each backend this reports:
+- the maximum and mean CIE76 delta E of RGBtoCIELCH against the exact conversion
+- the maximum delta E of the round trip, and the number of colours which did not come back unchanged
+- the number of colours which CIELCHtoRGB wrongly reported as imaginary (no sRGB colour is imaginary)
+- the wall time of the whole sweep, using all CPU cores
+
+Before the sweep, every function which CIELCHColour.h documents as allocation-free is called once
+while AllocationCounter counts the heap allocations of the thread. With juce_gui_basics, the tool
+also builds CIELCHThemes from random seeds and checks their WCAG 2 contrast ratios.
+
+The exit code is 1 if any backend exceeds its delta E limit, changes a colour in the round trip
+or reports an imaginary colour, if any of the allocation-free functions allocates, or if a
+theme misses a contrast ratio. So the tool
+can be run after every change to the conversions.
+
+The FastMath configuration builds the tool with -ffast-math (Projucer: "Relax IEEE compliance"),
+which projects using the module may enable. Then the compiler may use vectorised std::pow and
+reorder the arithmetic, so the exact conversions are checked with the limit of the fast ones, and
+the tables with a limit of a few units in the last place of a float.
+*/
+
+namespace
+{
+    /** The 2^24 colours are handled like an image of colourLineSize x colourLineSize pixels */
+    const int colourLineSize = 4096;
+
+    // with -ffast-math the std maths functions, which are the reference for the tables, are only
+    // accurate to a few units in the last place of a float
+   #if defined (__FAST_MATH__)
+    const bool isFastMathBuild = true;
+    const double exactMaxDeltaE = 0.0005;
+    const double maxTableDeviation = 1.0e-6;
+   #else
+    const bool isFastMathBuild = false;
+    const double exactMaxDeltaE = 0.0;
+    const double maxTableDeviation = 1.0e-7;
+   #endif
+
+    PixelARGB colourForIndex(int index) noexcept
+    {
+        return PixelARGB(255, (uint8) (index >> 16), (uint8) (index >> 8), (uint8) index);
+    }
+
+    /** The CIE76 delta E between two CIE LCH colours with CIELCHColour units (all 0...1).
+    This is the distance of the colours in CIE Lab, written in polar coordinates, so that the
+    exact conversion is compared with itself without the rounding errors of cos and sin.
+    */
+    double deltaE(float L1, float C1, float H1, float L2, float C2, float H2) noexcept
+    {
+        const double dL = ((double) L1 - (double) L2) * 100.0;
+        const double c1 = (double) C1 * 134.0;
+        const double c2 = (double) C2 * 134.0;
+        const double dC = c1 - c2;
+        const double halfAngle = std::sin(((double) H1 - (double) H2) * double_Pi);
+
+        return std::sqrt(dL * dL + dC * dC + 4.0 * c1 * c2 * halfAngle * halfAngle);
+    }
+
+    //==============================================================================
+    /** One implementation of the conversions */
+    struct Backend
+    {
+        String name;
+        double maxDeltaE;
+
+        std::function<void (const PixelARGB*, float*, float*, float*, int)> toCIELCH;
+        std::function<int (const float*, const float*, const float*, PixelARGB*, int)> toRGB;
+    };
+
+    /** The scalar functions of CIELCHColour, which are the reference for all other backends */
+    Backend createColourBackend()
+    {
+        Backend backend;
+        backend.name = "CIELCHColour";
+        backend.maxDeltaE = exactMaxDeltaE;
+
+        backend.toCIELCH = [] (const PixelARGB* pixels, float* L, float* C, float* H, int numPixels)
+        {
+            for (int i = 0; i < numPixels; ++i)
+                CIELCHColour::RGBtoCIELCH(CIELCHColour(pixels[i]), L[i], C[i], H[i]);
+        };
+
+        backend.toRGB = [] (const float* L, const float* C, const float* H, PixelARGB* pixels, int numPixels)
+        {
+            int numImaginary = 0;
+
+            for (int i = 0; i < numPixels; ++i)
+            {
+                CIELCHColour colour;
+                bool imaginary;
+                CIELCHColour::CIELCHtoRGB(L[i], C[i], H[i], colour, imaginary);
+
+                const Colour c = colour.getJuceColour();
+                pixels[i].setARGB(pixels[i].getAlpha(), c.getRed(), c.getGreen(), c.getBlue());
+                numImaginary += imaginary ? 1 : 0;
+            }
+
+            return numImaginary;
+        };
+
+        return backend;
+    }
+
+    /** CIELCHColourCache in front of the CIELCHColour functions. Every colour is looked up twice, so
+    that both the conversion on a miss and the cached values of a hit are checked.
+    */
+    Backend createColourCacheBackend()
+    {
+        Backend backend = createColourBackend();
+        backend.name = "CIELCHColourCache";
+
+        backend.toCIELCH = [] (const PixelARGB* pixels, float* L, float* C, float* H, int numPixels)
+        {
+            for (int i = 0; i < numPixels; ++i)
+            {
+                CIELCHColourCache::getCIELCH(CIELCHColour(pixels[i]), L[i], C[i], H[i]);
+                CIELCHColourCache::getCIELCH(CIELCHColour(pixels[i]), L[i], C[i], H[i]);
+            }
+        };
+
+        return backend;
+    }
+
+    /** The line conversions of CIELCHConversion, for each precision and available instruction set */
+    std::vector<Backend> createLineBackends()
+    {
+        const struct { CIELCHPrecision precision; const char* name; double maxDeltaE; } precisions[] =
+        {
+            // the limits leave some headroom over the values documented in CIELCHConversion.h
+            { CIELCHPrecision::exact,   "exact",   exactMaxDeltaE },
+            { CIELCHPrecision::fast,    "fast",    0.0005         },
+            { CIELCHPrecision::fastest, "fastest", 0.005          }
+        };
+
+        const CIELCHInstructionSet instructionSets[] =
+        {
+            CIELCHInstructionSet::generic, CIELCHInstructionSet::sse2, CIELCHInstructionSet::sse41,
+            CIELCHInstructionSet::avx2, CIELCHInstructionSet::avx512
+        };
+
+        std::vector<Backend> backends;
+
+        for (auto& p : precisions)
+        {
+            for (auto set : instructionSets)
+            {
+                // the exact conversions are the same for all instruction sets
+                if (p.precision == CIELCHPrecision::exact && set != CIELCHInstructionSet::generic)
+                    continue;
+
+                if (! CIELCHKernels::setInstructionSet(set))
+                    continue;
+
+                const CIELCHConverter converter(p.precision);
+
+                Backend backend;
+                backend.name = String(p.name) + "/" + CIELCHKernels::getName(set);
+                backend.maxDeltaE = p.maxDeltaE;
+
+                backend.toCIELCH = [converter] (const PixelARGB* pixels, float* L, float* C, float* H, int numPixels)
+                {
+                    converter.RGBtoCIELCH(pixels, L, C, H, numPixels);
+                };
+
+                backend.toRGB = [converter] (const float* L, const float* C, const float* H, PixelARGB* pixels, int numPixels)
+                {
+                    return converter.CIELCHtoRGB(L, C, H, pixels, numPixels);
+                };
+
+                backends.push_back(backend);
+            }
+        }
+
+        CIELCHKernels::resetInstructionSet();
+        return backends;
+    }
+
+    //==============================================================================
+    struct Statistics
+    {
+        double maxDeltaE = 0.0;
+        double sumDeltaE = 0.0;
+        double maxRoundTripDeltaE = 0.0;
+        int64 numChanged = 0;
+        int64 numImaginary = 0;
+
+        void merge(const Statistics& other) noexcept
+        {
+            maxDeltaE = jmax(maxDeltaE, other.maxDeltaE);
+            sumDeltaE += other.sumDeltaE;
+            maxRoundTripDeltaE = jmax(maxRoundTripDeltaE, other.maxRoundTripDeltaE);
+            numChanged += other.numChanged;
+            numImaginary += other.numImaginary;
+        }
+    };
+
+    typedef CIELCHConversion<CIELCHPrecision::exact> Reference;
+
+    /** Checks the colours of the lines startLine...endLine */
+    void checkLines(const Backend& backend, int startLine, int endLine, Statistics& statistics)
+    {
+        const size_t n = (size_t) colourLineSize;
+        std::vector<PixelARGB> source(n), result(n);
+        std::vector<float> refL(n), refC(n), refH(n), L(n), C(n), H(n);
+
+        for (int line = startLine; line < endLine; ++line)
+        {
+            for (int i = 0; i < colourLineSize; ++i)
+                source[(size_t) i] = colourForIndex(line * colourLineSize + i);
+
+            Reference::RGBtoCIELCH(source.data(), refL.data(), refC.data(), refH.data(), colourLineSize);
+
+            backend.toCIELCH(source.data(), L.data(), C.data(), H.data(), colourLineSize);
+            result = source;
+            statistics.numImaginary += backend.toRGB(L.data(), C.data(), H.data(), result.data(), colourLineSize);
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                const double forward = deltaE(L[i], C[i], H[i], refL[i], refC[i], refH[i]);
+                statistics.maxDeltaE = jmax(statistics.maxDeltaE, forward);
+                statistics.sumDeltaE += forward;
+
+                if (result[i].getNativeARGB() != source[i].getNativeARGB())
+                {
+                    ++statistics.numChanged;
+
+                    float resultL, resultC, resultH;
+                    Reference::RGBtoCIELCH(result[i], resultL, resultC, resultH);
+
+                    statistics.maxRoundTripDeltaE = jmax(statistics.maxRoundTripDeltaE,
+                                                         deltaE(resultL, resultC, resultH, refL[i], refC[i], refH[i]));
+                }
+            }
+        }
+    }
+
+    //==============================================================================
+    struct BackendResult
+    {
+        Statistics statistics;
+        double seconds;
+        bool passed;
+    };
+
+    BackendResult sweep(const Backend& backend)
+    {
+        std::vector<Statistics> workerStatistics((size_t) SystemStats::getNumCpus());
+
+        const int64 start = Time::getHighResolutionTicks();
+
+        CIELCHParallel::forEachRowRange(colourLineSize, colourLineSize, [&] (int startLine, int endLine, int worker)
+        {
+            checkLines(backend, startLine, endLine, workerStatistics[(size_t) worker]);
+        });
+
+        BackendResult result;
+        result.seconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+
+        for (auto& s : workerStatistics)
+            result.statistics.merge(s);
+
+        result.passed = result.statistics.maxDeltaE <= backend.maxDeltaE
+                         && result.statistics.numChanged == 0
+                         && result.statistics.numImaginary == 0;
+        return result;
+    }
+
+    //==============================================================================
+    /** Calls the function while counting allocations, and adds its name to the list if it allocated */
+    template <typename FunctionType>
+    void checkAllocations(const char* name, FunctionType function, StringArray& allocatingFunctions)
+    {
+        int numAllocations;
+
+        {
+            const AllocationCounter counter;
+            function();
+            numAllocations = counter.getNumAllocations();
+        }
+
+        if (numAllocations > 0)
+            allocatingFunctions.add(String(name) + " (" + String(numAllocations) + " allocations)");
+    }
+
+    /** Returns the allocation-free functions which allocated */
+    StringArray findAllocatingFunctions()
+    {
+        StringArray allocating;
+        const CIELCHColour colour(Colours::orange);
+        bool imaginary;
+        float L, C, H, X, Y, Z, a, b;
+
+       #if CIELCH_ENABLE_INSTRUMENTATION
+        // the first count of a thread may allocate, see CIELCHInstrumentation
+        colour.getCIELCH(L, C, H);
+       #endif
+
+        checkAllocations("constructors", [&]
+        {
+            CIELCHColour c1(Colours::orange), c2(c1), c3(0xff102030), c4((uint8) 1, (uint8) 2, (uint8) 3);
+            CIELCHColour c5(0.5f, 0.5f, 0.5f, 1.0f), c6(PixelARGB(255, 10, 20, 30));
+            c1 = c2;
+            c2 = Colours::red;
+            c3.getJuceColour();
+        }, allocating);
+
+        checkAllocations("fromCIELCH", [&] { CIELCHColour::fromCIELCH(0.5f, 0.9f, 0.3f, 1.0f, imaginary); }, allocating);
+        checkAllocations("getCIELCH", [&] { colour.getCIELCH(L, C, H); }, allocating);
+        checkAllocations("getCIELightness", [&] { colour.getCIELightness(); colour.getCIEChroma(); colour.getCIEHue(); }, allocating);
+        checkAllocations("withCIELightness", [&] { colour.withCIELightness(0.3f, imaginary); }, allocating);
+        checkAllocations("withCIEChroma", [&] { colour.withCIEChroma(0.3f, imaginary); }, allocating);
+        checkAllocations("withCIEHue", [&] { colour.withCIEHue(0.3f, imaginary); }, allocating);
+        checkAllocations("withMultipliedCIELightness", [&] { colour.withMultipliedCIELightness(1.2f, imaginary); }, allocating);
+        checkAllocations("withMultipliedCIEChroma", [&] { colour.withMultipliedCIEChroma(0.5f, imaginary); }, allocating);
+        checkAllocations("withRotatedCIEHue", [&] { colour.withRotatedCIEHue(0.1f, imaginary); }, allocating);
+        checkAllocations("CIELighter", [&] { colour.CIELighter(imaginary); colour.CIEDarker(imaginary); }, allocating);
+
+        checkAllocations("RGBtoXYZ", [&] { CIELCHColour::RGBtoXYZ(colour, X, Y, Z); }, allocating);
+        checkAllocations("XYZtoRGB", [&] { CIELCHColour c; CIELCHColour::XYZtoRGB(30.0f, 40.0f, 50.0f, c, imaginary); }, allocating);
+        checkAllocations("XYZtoCIELab", [&] { CIELCHColour::XYZtoCIELab(30.0f, 40.0f, 50.0f, L, a, b); }, allocating);
+        checkAllocations("CIELabtoXYZ", [&] { CIELCHColour::CIELabtoXYZ(50.0f, 20.0f, -30.0f, X, Y, Z); }, allocating);
+        checkAllocations("CIELabtoCIELCH", [&] { CIELCHColour::CIELabtoCIELCH(50.0f, 20.0f, -30.0f, L, C, H); }, allocating);
+        checkAllocations("CIELCHtoCIELab", [&] { CIELCHColour::CIELCHtoCIELab(50.0f, 60.0f, 120.0f, L, a, b); }, allocating);
+        checkAllocations("CIELCHtoRGB", [&] { CIELCHColour c; CIELCHColour::CIELCHtoRGB(0.5f, 0.4f, 0.3f, c, imaginary); }, allocating);
+        checkAllocations("RGBtoCIELCH", [&] { CIELCHColour::RGBtoCIELCH(colour, L, C, H); }, allocating);
+        checkAllocations("CIELCHColourCache", [&] { CIELCHColourCache::getCIELCH(colour, L, C, H); CIELCHColourCache::getCIELCH(colour, L, C, H); }, allocating);
+
+        const int numPixels = 300;
+        PixelARGB pixels[numPixels];
+        float lineL[numPixels], lineA[numPixels], lineB[numPixels];
+
+        for (int i = 0; i < numPixels; ++i)
+            pixels[i] = colourForIndex(i * 55711);
+
+        checkAllocations("line RGBtoCIELab", [&] { CIELCHColour::RGBtoCIELab(pixels, lineL, lineA, lineB, numPixels); }, allocating);
+        checkAllocations("line CIELabtoRGB", [&] { CIELCHColour::CIELabtoRGB(lineL, lineA, lineB, pixels, numPixels); }, allocating);
+
+        for (auto precision : { CIELCHPrecision::exact, CIELCHPrecision::fast, CIELCHPrecision::fastest })
+        {
+            checkAllocations("CIELCHConverter", [&]
+            {
+                const CIELCHConverter converter(precision);
+                converter.RGBtoCIELab(pixels, lineL, lineA, lineB, numPixels);
+                converter.CIELabtoCIELCH(lineA, lineB, lineA, lineB, numPixels);
+                converter.CIELCHtoCIELab(lineA, lineB, lineA, lineB, numPixels);
+                converter.CIELabtoRGB(lineL, lineA, lineB, pixels, numPixels);
+                converter.RGBtoCIELCH(pixels, lineL, lineA, lineB, numPixels);
+                converter.CIELCHtoRGB(lineL, lineA, lineB, pixels, numPixels);
+            }, allocating);
+        }
+
+        const CIELabPlaneTransform transform = CIELabPlaneTransform::hueRotation(0.1f)
+                                                   .followedBy(CIELabPlaneTransform::chromaMultiplication(0.8f));
+
+        checkAllocations("CIELabPlaneTransform", [&]
+        {
+            transform.apply(colour, imaginary);
+            transform.transformPoints(lineA, lineB, numPixels);
+        }, allocating);
+
+        return allocating;
+    }
+
+    /** Runs an identity function over a semi-transparent image with CIELCHImageJobQueue.
+    The pixels the function sees must be unpremultiplied exactly once, so the result must be the
+    same as reading and writing every line of the source once.
+    @returns the largest channel difference to that reference, 0 if the job is correct
+    */
+    int checkImageJob()
+    {
+        const int width = 67, height = 53;
+        Image source(Image::ARGB, width, height, false);
+
+        {
+            const Image::BitmapData data(source, Image::BitmapData::writeOnly);
+
+            for (int y = 0; y < height; ++y)
+            {
+                for (int x = 0; x < width; ++x)
+                {
+                    PixelARGB p = colourForIndex((y * width + x) * 48271);
+                    p.setAlpha((uint8) ((x * 7 + y * 13) % 256));
+                    p.premultiply();
+                    *reinterpret_cast<PixelARGB*>(data.getPixelPointer(x, y)) = p;
+                }
+            }
+        }
+
+        Image reference(Image::ARGB, width, height, false);
+
+        {
+            const Image::BitmapData sourceData(source, Image::BitmapData::readOnly);
+            const Image::BitmapData referenceData(reference, Image::BitmapData::writeOnly);
+            HeapBlock<PixelARGB> pixels((size_t) width);
+
+            for (int y = 0; y < height; ++y)
+            {
+                CIELCHImageLine::read(sourceData, y, pixels);
+                CIELCHImageLine::write(referenceData, y, pixels);
+            }
+        }
+
+        CIELCHImageJobQueue queue(2, 8);
+        const Image result = queue.submit(source, [] (PixelARGB*, int) {}, nullptr, false)->getResult().get();
+
+        if (! result.isValid())
+            return 255;
+
+        const Image::BitmapData resultData(result, Image::BitmapData::readOnly);
+        const Image::BitmapData referenceData(reference, Image::BitmapData::readOnly);
+        int maxDifference = 0;
+
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                const PixelARGB a = *reinterpret_cast<const PixelARGB*>(resultData.getPixelPointer(x, y));
+                const PixelARGB b = *reinterpret_cast<const PixelARGB*>(referenceData.getPixelPointer(x, y));
+
+                maxDifference = jmax(maxDifference,
+                                     jmax(std::abs(a.getAlpha() - b.getAlpha()), std::abs(a.getRed() - b.getRed()),
+                                          std::abs(a.getGreen() - b.getGreen()), std::abs(a.getBlue() - b.getBlue())));
+            }
+        }
+
+        return maxDifference;
+    }
+
+   #if JUCE_MODULE_AVAILABLE_juce_gui_basics
+    /** Builds themes from random seeds and checks the WCAG 2 contrast ratios which CIELCHTheme promises:
+    4.5 for text on its backgrounds, and 3 for disabled text.
+    @returns the smallest ratio divided by its required ratio, at least 1 if every theme is correct
+    */
+    double checkThemeContrast()
+    {
+        struct Pair { CIELCHTheme::Role foreground, background; float ratio; };
+
+        const Pair pairs[] =
+        {
+            { CIELCHTheme::text,          CIELCHTheme::background,      4.5f },
+            { CIELCHTheme::text,          CIELCHTheme::surface,         4.5f },
+            { CIELCHTheme::text,          CIELCHTheme::surfaceHover,    4.5f },
+            { CIELCHTheme::text,          CIELCHTheme::surfacePressed,  4.5f },
+            { CIELCHTheme::secondaryText, CIELCHTheme::background,      4.5f },
+            { CIELCHTheme::secondaryText, CIELCHTheme::surface,         4.5f },
+            { CIELCHTheme::disabledText,  CIELCHTheme::background,      3.0f },
+            { CIELCHTheme::disabledText,  CIELCHTheme::surfaceDisabled, 3.0f },
+            { CIELCHTheme::textOnAccent,  CIELCHTheme::accent,          4.5f },
+            { CIELCHTheme::textOnAccent,  CIELCHTheme::accentHover,     4.5f },
+            { CIELCHTheme::textOnAccent,  CIELCHTheme::accentPressed,   4.5f },
+            { CIELCHTheme::selectedText,  CIELCHTheme::selection,       4.5f }
+        };
+
+        double worst = 21.0;
+
+        auto check = [&] (const CIELCHTheme& theme)
+        {
+            for (auto& pair : pairs)
+            {
+                const float ratio = CIELCHTheme::getContrastRatio(theme.getColour(pair.foreground),
+                                                                  theme.getColour(pair.background));
+                worst = jmin(worst, (double) ratio / pair.ratio);
+            }
+        };
+
+        Random random(0x1ab);
+
+        for (int i = 0; i < 4096; ++i)
+        {
+            const CIELCHColour backgroundSeed(Colour((uint32) random.nextInt() | 0xff000000));
+            const CIELCHColour accentSeed(Colour((uint32) random.nextInt() | 0xff000000));
+
+            check(CIELCHTheme(backgroundSeed, accentSeed));
+            check(CIELCHTheme::fromAccent(accentSeed, true));
+            check(CIELCHTheme::fromAccent(accentSeed, false));
+        }
+
+        return worst;
+    }
+   #endif
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    String outputFile;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const String argument(argv[i]);
+
+        if (argument == "--output" && i + 1 < argc)
+        {
+            outputFile = argv[++i];
+        }
+        else
+        {
+            std::cerr << "Usage: CIELCHAccuracy [--output results.json]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<Backend> backends;
+    backends.push_back(createColourBackend());
+    backends.push_back(createColourCacheBackend());
+
+    for (auto& b : createLineBackends())
+        backends.push_back(b);
+
+    // after creating the converters, which detect the CPU features
+    const StringArray allocatingFunctions = findAllocatingFunctions();
+
+    if (allocatingFunctions.isEmpty())
+        std::cout << "allocation check: passed" << std::endl << std::endl;
+    else
+        std::cout << "allocation check: FAILED, " << allocatingFunctions.joinIntoString(", ") << std::endl << std::endl;
+
+    // the lookup tables must match the std maths functions up to the rounding to float
+    const double tableDeviation = CIELCHConversionTables::getMaxDeviationFromReference();
+    const bool tablesPassed = tableDeviation <= maxTableDeviation;
+
+    std::cout << "table check: " << (tablesPassed ? "passed" : "FAILED")
+              << (CIELCH_CONSTEXPR_TABLES ? ", built at compile time" : ", built at run time")
+              << ", max deviation " << String(tableDeviation, 10) << std::endl << std::endl;
+
+    // a job must hand unpremultiplied pixels to its function and premultiply them once on the way back
+    const int jobDifference = checkImageJob();
+    const bool jobPassed = jobDifference == 0;
+
+    std::cout << "image job check: " << (jobPassed ? "passed" : "FAILED")
+              << ", max difference " << jobDifference << std::endl << std::endl;
+
+   #if JUCE_MODULE_AVAILABLE_juce_gui_basics
+    // every theme must keep its text readable, whatever the seeds
+    const double contrastMargin = checkThemeContrast();
+    const bool contrastPassed = contrastMargin >= 1.0;
+
+    std::cout << "contrast check: " << (contrastPassed ? "passed" : "FAILED")
+              << ", worst ratio " << String(contrastMargin, 3) << " of the required" << std::endl << std::endl;
+   #else
+    const bool contrastPassed = true;
+   #endif
+
+    const int64 numColours = (int64) colourLineSize * colourLineSize;
+
+    std::cout << numColours << " colours, " << CIELCHParallel::getNumWorkers(colourLineSize, colourLineSize)
+              << " threads" << (isFastMathBuild ? ", built with -ffast-math" : "") << std::endl << std::endl
+              << "backend             max dE     mean dE    round trip dE  changed  imaginary  seconds" << std::endl;
+
+    var results { Array<var>() };
+    bool allPassed = allocatingFunctions.isEmpty() && tablesPassed && jobPassed && contrastPassed;
+
+    for (auto& backend : backends)
+    {
+        const BackendResult r = sweep(backend);
+        const Statistics& s = r.statistics;
+        const double meanDeltaE = s.sumDeltaE / (double) numColours;
+
+        std::cout << backend.name.paddedRight(' ', 18)
+                  << "  " << String(s.maxDeltaE, 6).paddedRight(' ', 9)
+                  << "  " << String(meanDeltaE, 6).paddedRight(' ', 9)
+                  << "  " << String(s.maxRoundTripDeltaE, 6).paddedRight(' ', 13)
+                  << "  " << String(s.numChanged).paddedRight(' ', 7)
+                  << "  " << String(s.numImaginary).paddedRight(' ', 9)
+                  << "  " << String(r.seconds, 2)
+                  << (r.passed ? "" : "  FAILED") << std::endl;
+
+        DynamicObject::Ptr result = new DynamicObject();
+        result->setProperty("backend", backend.name);
+        result->setProperty("maxDeltaE", s.maxDeltaE);
+        result->setProperty("meanDeltaE", meanDeltaE);
+        result->setProperty("deltaELimit", backend.maxDeltaE);
+        result->setProperty("maxRoundTripDeltaE", s.maxRoundTripDeltaE);
+        result->setProperty("changedColours", s.numChanged);
+        result->setProperty("imaginaryColours", s.numImaginary);
+        result->setProperty("seconds", r.seconds);
+        result->setProperty("passed", r.passed);
+        results.append(var(result.get()));
+
+        allPassed = allPassed && r.passed;
+    }
+
+    if (outputFile.isNotEmpty())
+    {
+        DynamicObject::Ptr root = new DynamicObject();
+        root->setProperty("colours", numColours);
+        root->setProperty("threads", CIELCHParallel::getNumWorkers(colourLineSize, colourLineSize));
+        root->setProperty("fastMath", isFastMathBuild);
+        root->setProperty("results", results);
+        root->setProperty("allocatingFunctions", var(allocatingFunctions));
+        root->setProperty("constexprTables", CIELCH_CONSTEXPR_TABLES != 0);
+        root->setProperty("tableDeviation", tableDeviation);
+        root->setProperty("imageJobDifference", jobDifference);
+       #if JUCE_MODULE_AVAILABLE_juce_gui_basics
+        root->setProperty("contrastMargin", contrastMargin);
+       #endif
+
+        if (! File::getCurrentWorkingDirectory().getChildFile(outputFile).replaceWithText(JSON::toString(var(root.get()))))
+            return 1;
+    }
+
+    return allPassed ? 0 : 1;
+}
@@ -0,0 +1,485 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <functional>
+#include <iostream>
+#include <memory>
+
+/*
+Applies CIE LCH colour adjustments to all PNG and JPEG files of a directory.
+
+Usage: CIELCHBatch --op <spec> --input <directory> --output <directory> [--recursive]
+                   [--io-threads n] [--process-threads n] [--precision exact|fast|fastest]
+                   [--jpeg-quality 0...1]
+
+The operation spec is a comma separated list. The parts are always applied in this order:
+
+normalise[=percent]   stretches the lightness to the full range, clipping percent % of the pixels
+                      at each end (default 0.5)
+chroma=multiplier     multiplies the CIE chroma, like CIELCHColour::withMultipliedCIEChroma;
+                      0 desaturates completely
+hue=amount            rotates the CIE hue, in the range 0...1 like CIELCHColour::withRotatedCIEHue
+
+e.g. CIELCHBatch --op normalise,chroma=0.5 --input assets --output assets-disabled --recursive
+
+The files are decoded, processed and encoded in a pipeline: one thread pool decodes and encodes,
+another one converts the colours. Each image is converted by a single thread, so that the
+processing pool keeps all cores busy without nested threads. At most a few images per thread are
+decoded ahead, so the memory stays bounded for any number of files. The output keeps the relative
+path and the format of each input file. The throughput of every stage is printed at the end.
+
+The tool only needs juce_core, juce_events and juce_graphics, so it runs on headless Linux machines.
+*/
+
+namespace
+{
+    struct Operation
+    {
+        bool normalise = false;
+        float clipPercent = 0.5f;
+
+        bool hasTransform = false;
+        CIELabPlaneTransform transform;
+
+        /** Parses an operation spec, see the usage. Returns an error message, or an empty string. */
+        String parse(const String& spec)
+        {
+            StringArray parts;
+            parts.addTokens(spec, ",", "");
+            parts.trim();
+            parts.removeEmptyStrings();
+
+            if (parts.isEmpty())
+                return "empty operation spec";
+
+            for (auto& part : parts)
+            {
+                const String name = part.upToFirstOccurrenceOf("=", false, false).trim();
+                const String value = part.fromFirstOccurrenceOf("=", false, false).trim();
+
+                if (name == "normalise" || name == "normalize")
+                {
+                    normalise = true;
+
+                    if (value.isNotEmpty())
+                        clipPercent = jlimit(0.0f, 49.0f, value.getFloatValue());
+                }
+                else if (name == "chroma" && value.isNotEmpty())
+                {
+                    transform = transform.followedBy(CIELabPlaneTransform::chromaMultiplication(value.getFloatValue()));
+                    hasTransform = true;
+                }
+                else if (name == "hue" && value.isNotEmpty())
+                {
+                    transform = transform.followedBy(CIELabPlaneTransform::hueRotation(value.getFloatValue()));
+                    hasTransform = true;
+                }
+                else
+                {
+                    return "unknown operation '" + part + "'";
+                }
+            }
+
+            return {};
+        }
+    };
+
+    //==============================================================================
+    /** Returns a levels curve which stretches the lightness range of the visible pixels of an image
+    to 0...1, clipping clipPercent % of the pixels at each end.
+    */
+    CIELCHToneCurve createNormalisationCurve(const Image::BitmapData& data, const CIELCHConverter& converter,
+                                             float clipPercent)
+    {
+        enum { numBins = 1000 };
+        HeapBlock<int64> histogram(numBins, true);
+
+        HeapBlock<PixelARGB> pixels((size_t) data.width);
+        HeapBlock<int> positions((size_t) data.width);
+        HeapBlock<float> L((size_t) data.width), a((size_t) data.width), b((size_t) data.width);
+        int64 numPixels = 0;
+
+        for (int y = 0; y < data.height; ++y)
+        {
+            const int num = CIELCHImageLine::readVisible(data, y, pixels, positions);
+            converter.RGBtoCIELab(pixels, L, a, b, num);
+
+            for (int i = 0; i < num; ++i)
+                ++histogram[jlimit(0, numBins - 1, (int) (L[i] * (numBins / 100.0f)))];
+
+            numPixels += num;
+        }
+
+        const int64 numClipped = (int64) (numPixels * clipPercent / 100.0f);
+
+        int black = 0, white = numBins - 1;
+
+        for (int64 sum = 0; black < numBins - 1 && (sum += histogram[black]) <= numClipped;)
+            ++black;
+
+        for (int64 sum = 0; white > 0 && (sum += histogram[white]) <= numClipped;)
+            --white;
+
+        if (white <= black)
+            return CIELCHToneCurve();
+
+        return CIELCHToneCurve::levels(black / (float) numBins, (white + 1) / (float) numBins);
+    }
+
+    /** Applies the operation to an image in place, on the calling thread */
+    void applyOperation(Image& image, const Operation& operation, const CIELCHConverter& converter)
+    {
+        if (!image.isValid() || image.getFormat() == Image::SingleChannel)
+            return;
+
+        const Image::BitmapData data(image, Image::BitmapData::readWrite);
+
+        const CIELCHToneCurve curve = operation.normalise
+                                    ? createNormalisationCurve(data, converter, operation.clipPercent)
+                                    : CIELCHToneCurve();
+
+        HeapBlock<PixelARGB> pixels((size_t) data.width);
+        HeapBlock<int> positions((size_t) data.width);
+        HeapBlock<float> L((size_t) data.width), a((size_t) data.width), b((size_t) data.width);
+
+        for (int y = 0; y < data.height; ++y)
+        {
+            // the alpha doesn't change, so fully transparent pixels are skipped
+            const int num = CIELCHImageLine::readVisible(data, y, pixels, positions);
+
+            converter.RGBtoCIELab(pixels, L, a, b, num);
+
+            if (operation.normalise)
+                curve.applyToCIELab(L, a, b, num);
+
+            if (operation.hasTransform)
+                operation.transform.transformPoints(a, b, num);
+
+            converter.CIELabtoRGB(L, a, b, pixels, num);
+            CIELCHImageLine::writeVisible(data, y, pixels, positions, num);
+        }
+    }
+
+    //==============================================================================
+    struct Settings
+    {
+        File input, output;
+        bool recursive = false;
+        int numIOThreads = SystemStats::getNumCpus();
+        int numProcessThreads = SystemStats::getNumCpus();
+        CIELCHPrecision precision = CIELCHPrecision::exact;
+        float jpegQuality = 0.9f;
+    };
+
+    /** The work and the time of one stage of the pipeline, summed over all its threads */
+    struct Stage
+    {
+        Stage(const char* stageName, int threads) : name(stageName), numThreads(threads) {}
+
+        void add(int64 startTicks, int64 bytes, int64 pixels) noexcept
+        {
+            ticks += Time::getHighResolutionTicks() - startTicks;
+            numBytes += bytes;
+            numPixels += pixels;
+            ++numFiles;
+        }
+
+        void print() const
+        {
+            const double busySeconds = Time::highResolutionTicksToSeconds(ticks);
+
+            // the throughput of the whole pool, if all of its threads were busy with this stage
+            const double poolSeconds = jmax(1.0e-9, busySeconds / numThreads);
+
+            std::cout << String(name).paddedRight(' ', 9)
+                      << String(numFiles.load()).paddedLeft(' ', 8) << " files"
+                      << String(numBytes / 1.0e6, 1).paddedLeft(' ', 10) << " MB"
+                      << String(numPixels / 1.0e6, 1).paddedLeft(' ', 10) << " Mpixels"
+                      << String(busySeconds, 2).paddedLeft(' ', 9) << " s busy in " << numThreads << " threads:"
+                      << String(numFiles / poolSeconds, 1).paddedLeft(' ', 9) << " files/s"
+                      << String(numPixels / 1.0e6 / poolSeconds, 1).paddedLeft(' ', 9) << " Mpixels/s"
+                      << std::endl;
+        }
+
+        const char* const name;
+        const int numThreads;
+        std::atomic<int64> ticks { 0 }, numBytes { 0 }, numPixels { 0 }, numFiles { 0 };
+    };
+
+    /** A ThreadPoolJob which calls a function once */
+    class FunctionJob  : public ThreadPoolJob
+    {
+    public:
+
+        explicit FunctionJob(std::function<void()> functionToCall)
+            : ThreadPoolJob("CIELCHBatch"), function(std::move(functionToCall))
+        {
+        }
+
+        JobStatus runJob() override
+        {
+            function();
+            return jobHasFinished;
+        }
+
+    private:
+
+        std::function<void()> function;
+    };
+
+    //==============================================================================
+    /** Decodes, processes and encodes the files with two thread pools.
+    Every file passes through decode (I/O pool) -> process (processing pool) -> encode (I/O pool).
+    */
+    class Pipeline
+    {
+    public:
+
+        Pipeline(const Settings& s, const Operation& o)
+            : settings(s), operation(o), converter(s.precision),
+              decodeStage("decode", s.numIOThreads),
+              processStage("process", s.numProcessThreads),
+              encodeStage("encode", s.numIOThreads),
+              ioPool(s.numIOThreads), processPool(s.numProcessThreads)
+        {
+        }
+
+        /** Processes all files, and returns when they are written */
+        void run(const Array<File>& files)
+        {
+            const int maxInFlight = 2 * (settings.numIOThreads + settings.numProcessThreads);
+            const int64 start = Time::getHighResolutionTicks();
+
+            for (auto& file : files)
+            {
+                while (numInFlight >= maxInFlight)
+                    slotFreed.wait(100);
+
+                ++numInFlight;
+
+                auto item = std::make_shared<Item>();
+                item->source = file;
+                item->destination = settings.output.getChildFile(file.getRelativePathFrom(settings.input));
+
+                ioPool.addJob(new FunctionJob([this, item] { decode(item); }), true);
+            }
+
+            while (numInFlight > 0)
+                slotFreed.wait(100);
+
+            wallSeconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+        }
+
+        int getNumFailed() const noexcept   { return numFailed; }
+
+        void printStatistics() const
+        {
+            decodeStage.print();
+            processStage.print();
+            encodeStage.print();
+
+            std::cout << encodeStage.numFiles.load() << " files written, " << numFailed.load() << " failed, in "
+                      << String(wallSeconds, 2) << " s (" << String(encodeStage.numFiles / jmax(1.0e-9, wallSeconds), 1)
+                      << " files/s)" << std::endl;
+        }
+
+    private:
+
+        struct Item
+        {
+            File source, destination;
+            Image image;
+        };
+
+        void decode(std::shared_ptr<Item> item)
+        {
+            const int64 start = Time::getHighResolutionTicks();
+
+            MemoryBlock data;
+
+            if (item->source.loadFileAsData(data))
+                item->image = ImageFileFormat::loadFrom(data.getData(), data.getSize());
+
+            if (!item->image.isValid())
+                return fail(*item, "can't decode");
+
+            decodeStage.add(start, (int64) data.getSize(), (int64) item->image.getWidth() * item->image.getHeight());
+
+            processPool.addJob(new FunctionJob([this, item] { process(item); }), true);
+        }
+
+        void process(std::shared_ptr<Item> item)
+        {
+            const int64 start = Time::getHighResolutionTicks();
+
+            applyOperation(item->image, operation, converter);
+
+            processStage.add(start, 0, (int64) item->image.getWidth() * item->image.getHeight());
+
+            ioPool.addJob(new FunctionJob([this, item] { encode(item); }), true);
+        }
+
+        void encode(std::shared_ptr<Item> item)
+        {
+            const int64 start = Time::getHighResolutionTicks();
+
+            PNGImageFormat png;
+            JPEGImageFormat jpeg;
+            jpeg.setQuality(settings.jpegQuality);
+
+            ImageFileFormat& format = item->destination.hasFileExtension("png") ? (ImageFileFormat&) png
+                                                                                : (ImageFileFormat&) jpeg;
+            MemoryOutputStream stream;
+
+            if (!format.writeImageToStream(item->image, stream))
+                return fail(*item, "can't encode");
+
+            if (item->destination.getParentDirectory().createDirectory().failed()
+                || !item->destination.replaceWithData(stream.getData(), stream.getDataSize()))
+                return fail(*item, "can't write");
+
+            encodeStage.add(start, (int64) stream.getDataSize(), (int64) item->image.getWidth() * item->image.getHeight());
+
+            --numInFlight;
+            slotFreed.signal();
+        }
+
+        void fail(const Item& item, const char* reason)
+        {
+            {
+                const ScopedLock sl(errorLock);
+                std::cerr << reason << ": " << item.source.getFullPathName() << std::endl;
+            }
+
+            ++numFailed;
+            --numInFlight;
+            slotFreed.signal();
+        }
+
+        const Settings settings;
+        const Operation operation;
+        const CIELCHConverter converter;
+
+        Stage decodeStage, processStage, encodeStage;
+
+        std::atomic<int> numInFlight { 0 }, numFailed { 0 };
+        WaitableEvent slotFreed;
+        CriticalSection errorLock;
+        double wallSeconds = 0.0;
+
+        // destroyed first, so that no job is still running when the other members go away
+        ThreadPool ioPool, processPool;
+    };
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    const char* usage = "Usage: CIELCHBatch --op <spec> --input <directory> --output <directory> [--recursive]\n"
+                        "                   [--io-threads n] [--process-threads n] [--precision exact|fast|fastest]\n"
+                        "                   [--jpeg-quality 0...1]\n"
+                        "spec: comma separated list of normalise[=percent], chroma=multiplier, hue=amount (0...1)";
+
+    Settings settings;
+    Operation operation;
+    String spec;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const String argument(argv[i]);
+        const bool hasValue = i + 1 < argc;
+
+        if (argument == "--op" && hasValue)
+            spec = argv[++i];
+        else if (argument == "--input" && hasValue)
+            settings.input = File::getCurrentWorkingDirectory().getChildFile(argv[++i]);
+        else if (argument == "--output" && hasValue)
+            settings.output = File::getCurrentWorkingDirectory().getChildFile(argv[++i]);
+        else if (argument == "--recursive")
+            settings.recursive = true;
+        else if (argument == "--io-threads" && hasValue)
+            settings.numIOThreads = jmax(1, String(argv[++i]).getIntValue());
+        else if (argument == "--process-threads" && hasValue)
+            settings.numProcessThreads = jmax(1, String(argv[++i]).getIntValue());
+        else if (argument == "--jpeg-quality" && hasValue)
+            settings.jpegQuality = jlimit(0.0f, 1.0f, String(argv[++i]).getFloatValue());
+        else if (argument == "--precision" && hasValue)
+        {
+            const String precision(argv[++i]);
+
+            if (precision == "exact")         settings.precision = CIELCHPrecision::exact;
+            else if (precision == "fast")     settings.precision = CIELCHPrecision::fast;
+            else if (precision == "fastest")  settings.precision = CIELCHPrecision::fastest;
+            else { std::cerr << usage << std::endl; return 1; }
+        }
+        else
+        {
+            std::cerr << usage << std::endl;
+            return 1;
+        }
+    }
+
+    if (spec.isEmpty() || settings.input == File() || settings.output == File())
+    {
+        std::cerr << usage << std::endl;
+        return 1;
+    }
+
+    const String error = operation.parse(spec);
+
+    if (error.isNotEmpty())
+    {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+
+    if (!settings.input.isDirectory() || settings.output == settings.input)
+    {
+        std::cerr << "The input must be a directory, and the output a different directory" << std::endl;
+        return 1;
+    }
+
+    const Array<File> files = settings.input.findChildFiles(File::findFiles, settings.recursive, "*.png;*.jpg;*.jpeg;*.PNG;*.JPG;*.JPEG");
+
+    std::cout << files.size() << " files, " << settings.numIOThreads << " I/O threads, "
+              << settings.numProcessThreads << " processing threads" << std::endl;
+
+    Pipeline pipeline(settings, operation);
+    pipeline.run(files);
+    pipeline.printStatistics();
+
+    return pipeline.getNumFailed() > 0 ? 1 : 0;
+}
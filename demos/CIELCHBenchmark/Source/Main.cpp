@@ -0,0 +1,684 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/*
+Measures the throughput of the CIELCH conversions and writes the results as JSON.
+
+Usage: CIELCHBenchmark [--quick] [--output results.json]
+
+--quick     shorter measurements, and no 8K images
+--output    writes the JSON to a file instead of stdout
+
+Every result is the fastest of several runs, in nanoseconds per colour (or per pixel, or per
+theme). The
+progress is written to stderr, so that stdout can be piped into a file or a comparison script.
+*/
+
+namespace
+{
+    /** Keeps the compiler from optimising away the benchmarked calls */
+    volatile uint32 sink = 0;
+
+    void consume(uint32 value) noexcept      { sink = sink + value; }
+    void consume(float value) noexcept       { uint32 bits; std::memcpy(&bits, &value, sizeof(bits)); consume(bits); }
+    void consume(const CIELCHColour& c)      { consume(c.getJuceColour().getARGB()); }
+
+    //==============================================================================
+    struct Settings
+    {
+        bool quick = false;
+        double minimumSeconds = 0.25;
+        int numRuns = 5;
+    };
+
+    /** Calls the function (which processes numColours colours) until it has run at least
+    settings.numRuns times and for settings.minimumSeconds, and returns the fastest run in seconds.
+    */
+    template <typename FunctionType>
+    double timeFastestRun(const Settings& settings, FunctionType function)
+    {
+        double fastest = std::numeric_limits<double>::max();
+        double total = 0.0;
+
+        for (int run = 0; run < settings.numRuns || total < settings.minimumSeconds; ++run)
+        {
+            const int64 start = Time::getHighResolutionTicks();
+            function();
+            const double seconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+
+            fastest = jmin(fastest, seconds);
+            total += seconds;
+        }
+
+        return fastest;
+    }
+
+    /** Like timeFastestRun, but calls prepare before every run, outside of the timed region.
+    Functions which process an image in place use it to start every run from the same pixels.
+    */
+    template <typename PrepareType, typename FunctionType>
+    double timeFastestRun(const Settings& settings, PrepareType prepare, FunctionType function)
+    {
+        double fastest = std::numeric_limits<double>::max();
+        double total = 0.0;
+
+        for (int run = 0; run < settings.numRuns || total < settings.minimumSeconds; ++run)
+        {
+            prepare();
+
+            const int64 start = Time::getHighResolutionTicks();
+            function();
+            const double seconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+
+            fastest = jmin(fastest, seconds);
+            total += seconds;
+        }
+
+        return fastest;
+    }
+
+    /** Copies the pixels of an image into another one of the same size and format, without allocating */
+    void copyPixels(const Image& source, Image& dest)
+    {
+        const Image::BitmapData sourceData(source, Image::BitmapData::readOnly);
+        const Image::BitmapData destData(dest, Image::BitmapData::writeOnly);
+
+        for (int y = 0; y < sourceData.height; ++y)
+            std::memcpy(destData.getLinePointer(y), sourceData.getLinePointer(y),
+                        (size_t) (sourceData.width * sourceData.pixelStride));
+    }
+
+    /** Copies the planes of a CIELCHImageBuffer into another one of the same size, without allocating */
+    void copyPlanes(const CIELCHImageBuffer& source, CIELCHImageBuffer& dest)
+    {
+        const size_t numBytes = (size_t) source.getWidth() * sizeof (float);
+
+        for (int y = 0; y < source.getHeight(); ++y)
+        {
+            std::memcpy(dest.getL(y), source.getL(y), numBytes);
+            std::memcpy(dest.getC(y), source.getC(y), numBytes);
+            std::memcpy(dest.getH(y), source.getH(y), numBytes);
+            std::memcpy(dest.getAlpha(y), source.getAlpha(y), numBytes);
+        }
+    }
+
+    //==============================================================================
+    /** Collects the results as an array of JSON objects */
+    class Results
+    {
+    public:
+
+        void add(const String& group, const String& name, const String& variant,
+                 int64 numColours, int numThreads, double seconds)
+        {
+            const double nsPerColour = seconds * 1.0e9 / (double) numColours;
+
+            DynamicObject::Ptr result = new DynamicObject();
+            result->setProperty("group", group);
+            result->setProperty("name", name);
+            result->setProperty("variant", variant);
+            result->setProperty("colours", numColours);
+            result->setProperty("threads", numThreads);
+            result->setProperty("nsPerColour", nsPerColour);
+            results.append(var(result.get()));
+
+            std::cerr << group << " / " << name << " / " << variant << ": "
+                      << String(nsPerColour, 2) << " ns" << std::endl;
+        }
+
+        var toJSON() const
+        {
+            DynamicObject::Ptr system = new DynamicObject();
+            system->setProperty("operatingSystem", SystemStats::getOperatingSystemName());
+            system->setProperty("cpuVendor", SystemStats::getCpuVendor());
+            system->setProperty("numCpus", SystemStats::getNumCpus());
+            system->setProperty("instructionSet", CIELCHKernels::getName(CIELCHKernels::getBestInstructionSet()));
+
+            DynamicObject::Ptr root = new DynamicObject();
+            root->setProperty("system", var(system.get()));
+            root->setProperty("results", results);
+            return var(root.get());
+        }
+
+    private:
+
+        var results { Array<var>() };
+    };
+
+    //==============================================================================
+    /** The same random opaque colours for every run */
+    std::vector<CIELCHColour> createTestColours(int numColours)
+    {
+        Random random(0x1ab);
+        std::vector<CIELCHColour> colours;
+        colours.reserve((size_t) numColours);
+
+        for (int i = 0; i < numColours; ++i)
+            colours.push_back(CIELCHColour(Colour((uint32) random.nextInt() | 0xff000000u)));
+
+        return colours;
+    }
+
+    /** An image with smooth gradients of all hues, and some noise so that no line is constant */
+    Image createTestImage(int width, int height)
+    {
+        Image image(Image::ARGB, width, height, false);
+        const Image::BitmapData data(image, Image::BitmapData::writeOnly);
+        Random random(0x1ab);
+
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                const float hue = (float) x / (float) width;
+                const float brightness = 0.2f + 0.8f * (float) y / (float) height;
+                const Colour c = Colour::fromHSV(hue, 0.7f, brightness, 1.0f)
+                                     .withMultipliedBrightness(0.95f + 0.1f * random.nextFloat());
+
+                reinterpret_cast<PixelARGB*>(data.getPixelPointer(x, y))->setARGB(255, c.getRed(), c.getGreen(), c.getBlue());
+            }
+        }
+
+        return image;
+    }
+
+    /** Flat artwork: rectangles in 256 colours, with a quarter of them semi-transparent */
+    Image createFlatTestImage(int width, int height)
+    {
+        Image image(Image::ARGB, width, height, false);
+        const Image::BitmapData data(image, Image::BitmapData::writeOnly);
+        Random random(0x1ab);
+        PixelARGB palette[256];
+
+        for (auto& p : palette)
+        {
+            p = Colour((uint32) random.nextInt()).withAlpha(random.nextInt(4) == 0 ? (uint8) random.nextInt(256) : (uint8) 255).getPixelARGB();
+            p.premultiply();
+        }
+
+        for (int y = 0; y < height; ++y)
+            for (int x = 0; x < width; ++x)
+                *reinterpret_cast<PixelARGB*>(data.getPixelPointer(x, y)) = palette[((x / 40) * 7 + (y / 24) * 13) & 255];
+
+        return image;
+    }
+
+    //==============================================================================
+    /** The CIELCHColour functions, one colour at a time */
+    void benchmarkColourFunctions(const Settings& settings, Results& results)
+    {
+        const int numColours = 1 << 16;
+        const std::vector<CIELCHColour> colours = createTestColours(numColours);
+
+        std::vector<float> L((size_t) numColours), C((size_t) numColours), H((size_t) numColours);
+
+        for (size_t i = 0; i < colours.size(); ++i)
+            colours[i].getCIELCH(L[i], C[i], H[i]);
+
+        auto add = [&] (const char* name, std::function<void()> function)
+        {
+            results.add("colour", name, "exact", numColours, 1, timeFastestRun(settings, function));
+        };
+
+        add("RGBtoCIELCH", [&]
+        {
+            float l, c, h;
+            for (auto& colour : colours) { CIELCHColour::RGBtoCIELCH(colour, l, c, h); consume(l + c + h); }
+        });
+
+        add("CIELCHtoRGB", [&]
+        {
+            CIELCHColour colour;
+            bool imaginary;
+            for (int i = 0; i < numColours; ++i) { CIELCHColour::CIELCHtoRGB(L[i], C[i], H[i], colour, imaginary); consume(colour); }
+        });
+
+        add("getCIELCH", [&]
+        {
+            float l, c, h;
+            for (auto& colour : colours) { colour.getCIELCH(l, c, h); consume(l + c + h); }
+        });
+
+        add("fromCIELCH", [&]
+        {
+            bool imaginary;
+            for (int i = 0; i < numColours; ++i) consume(CIELCHColour::fromCIELCH(L[i], C[i], H[i], 1.0f, imaginary));
+        });
+
+        // a user interface converts the same few hundred colours again and again
+        const int paletteSize = 300;
+
+        add("RGBtoCIELCH (300 colours)", [&]
+        {
+            float l, c, h;
+            for (int i = 0; i < numColours; ++i) { CIELCHColour::RGBtoCIELCH(colours[(size_t) (i % paletteSize)], l, c, h); consume(l + c + h); }
+        });
+
+        add("CIELCHColourCache (300 colours)", [&]
+        {
+            float l, c, h;
+            for (int i = 0; i < numColours; ++i) { CIELCHColourCache::getCIELCH(colours[(size_t) (i % paletteSize)], l, c, h); consume(l + c + h); }
+        });
+
+        //==============================================================================
+        typedef CIELCHColour (*Modification)(const CIELCHColour&, float, bool&);
+
+        struct Operation { const char* name; Modification modify; float amount; };
+
+        const Operation operations[] =
+        {
+            { "withCIELightness",           [] (const CIELCHColour& c, float x, bool& i) { return c.withCIELightness(x, i); },            0.6f  },
+            { "withCIEChroma",              [] (const CIELCHColour& c, float x, bool& i) { return c.withCIEChroma(x, i); },               0.3f  },
+            { "withCIEHue",                 [] (const CIELCHColour& c, float x, bool& i) { return c.withCIEHue(x, i); },                  0.25f },
+            { "withMultipliedCIELightness", [] (const CIELCHColour& c, float x, bool& i) { return c.withMultipliedCIELightness(x, i); },  1.2f  },
+            { "withMultipliedCIEChroma",    [] (const CIELCHColour& c, float x, bool& i) { return c.withMultipliedCIEChroma(x, i); },     0.5f  },
+            { "withRotatedCIEHue",          [] (const CIELCHColour& c, float x, bool& i) { return c.withRotatedCIEHue(x, i); },           0.1f  },
+            { "CIELighter",                 [] (const CIELCHColour& c, float x, bool& i) { return c.CIELighter(i, x); },                  0.4f  },
+            { "CIEDarker",                  [] (const CIELCHColour& c, float x, bool& i) { return c.CIEDarker(i, x); },                   0.4f  }
+        };
+
+        for (auto& operation : operations)
+        {
+            add(operation.name, [&]
+            {
+                bool imaginary;
+                for (auto& colour : colours) consume(operation.modify(colour, operation.amount, imaginary));
+            });
+        }
+
+        //==============================================================================
+        std::vector<float> X((size_t) numColours), Y((size_t) numColours), Z((size_t) numColours);
+        std::vector<float> labL((size_t) numColours), labA((size_t) numColours), labB((size_t) numColours);
+
+        for (int i = 0; i < numColours; ++i)
+        {
+            CIELCHColour::RGBtoXYZ(colours[(size_t) i], X[i], Y[i], Z[i]);
+            CIELCHColour::XYZtoCIELab(X[i], Y[i], Z[i], labL[i], labA[i], labB[i]);
+        }
+
+        add("RGBtoXYZ", [&]
+        {
+            float x, y, z;
+            for (auto& colour : colours) { CIELCHColour::RGBtoXYZ(colour, x, y, z); consume(x + y + z); }
+        });
+
+        add("XYZtoRGB", [&]
+        {
+            CIELCHColour colour;
+            bool imaginary;
+            for (int i = 0; i < numColours; ++i) { CIELCHColour::XYZtoRGB(X[i], Y[i], Z[i], colour, imaginary); consume(colour); }
+        });
+
+        add("XYZtoCIELab", [&]
+        {
+            float l, a, b;
+            for (int i = 0; i < numColours; ++i) { CIELCHColour::XYZtoCIELab(X[i], Y[i], Z[i], l, a, b); consume(l + a + b); }
+        });
+
+        add("CIELabtoXYZ", [&]
+        {
+            float x, y, z;
+            for (int i = 0; i < numColours; ++i) { CIELCHColour::CIELabtoXYZ(labL[i], labA[i], labB[i], x, y, z); consume(x + y + z); }
+        });
+
+        add("CIELabtoCIELCH", [&]
+        {
+            float l, c, h;
+            for (int i = 0; i < numColours; ++i) { CIELCHColour::CIELabtoCIELCH(labL[i], labA[i], labB[i], l, c, h); consume(l + c + h); }
+        });
+
+        add("CIELCHtoCIELab", [&]
+        {
+            float l, a, b;
+            for (int i = 0; i < numColours; ++i) { CIELCHColour::CIELCHtoCIELab(L[i] * 100.0f, C[i] * 134.0f, H[i] * 360.0f, l, a, b); consume(l + a + b); }
+        });
+    }
+
+    //==============================================================================
+    /** The line conversions for every precision and every available instruction set */
+    void benchmarkLineConversions(const Settings& settings, Results& results)
+    {
+        const int lineLength = 4096;
+        const int numLines = settings.quick ? 16 : 64;
+        const int numPixels = lineLength * numLines;
+
+        const std::vector<CIELCHColour> colours = createTestColours(numPixels);
+        std::vector<PixelARGB> pixels((size_t) numPixels);
+
+        for (int i = 0; i < numPixels; ++i)
+            pixels[(size_t) i] = colours[(size_t) i].getJuceColour().getPixelARGB();
+
+        std::vector<float> L((size_t) numPixels), C((size_t) numPixels), H((size_t) numPixels);
+
+        const CIELCHPrecision precisions[] = { CIELCHPrecision::exact, CIELCHPrecision::fast, CIELCHPrecision::fastest };
+        const char* precisionNames[] = { "exact", "fast", "fastest" };
+
+        for (int set = (int) CIELCHInstructionSet::generic; set <= (int) CIELCHInstructionSet::avx512; ++set)
+        {
+            if (! CIELCHKernels::setInstructionSet((CIELCHInstructionSet) set))
+                continue;
+
+            for (int p = 0; p < 3; ++p)
+            {
+                // the exact kernels are the same for every instruction set
+                if (precisions[p] == CIELCHPrecision::exact && set != (int) CIELCHInstructionSet::generic)
+                    continue;
+
+                const CIELCHConverter converter(precisions[p]);
+                const String variant = String(precisionNames[p]) + " " + CIELCHKernels::getName((CIELCHInstructionSet) set);
+
+                results.add("line", "RGBtoCIELCH", variant, numPixels, 1, timeFastestRun(settings, [&]
+                {
+                    for (int start = 0; start < numPixels; start += lineLength)
+                        converter.RGBtoCIELCH(pixels.data() + start, L.data() + start, C.data() + start, H.data() + start, lineLength);
+                }));
+
+                results.add("line", "CIELCHtoRGB", variant, numPixels, 1, timeFastestRun(settings, [&]
+                {
+                    for (int start = 0; start < numPixels; start += lineLength)
+                        consume((uint32) converter.CIELCHtoRGB(L.data() + start, C.data() + start, H.data() + start, pixels.data() + start, lineLength));
+                }));
+            }
+        }
+
+        CIELCHKernels::resetInstructionSet();
+    }
+
+    //==============================================================================
+    /** Mapping values to colours with colour map tables of different sizes */
+    void benchmarkColourMaps(const Settings& settings, Results& results)
+    {
+        const int lineLength = 4096;
+        const int numLines = settings.quick ? 64 : 256;
+        const int numValues = lineLength * numLines;
+
+        std::vector<float> values((size_t) numValues);
+        Random random(0x1ab);
+
+        for (auto& v : values)
+            v = random.nextFloat() * 120.0f - 110.0f;
+
+        std::vector<PixelARGB> pixels((size_t) lineLength);
+
+        for (int numEntries : { 256, 1024, 4096 })
+        {
+            const CIELCHColourMap map = CIELCHColourMap::constantChromaRamp(0.1f, 0.95f, 0.4f, 0.7f, -0.6f, numEntries);
+
+            results.add("colour map", "mapValues", String(numEntries) + " entries", numValues, 1, timeFastestRun(settings, [&]
+            {
+                for (int start = 0; start < numValues; start += lineLength)
+                {
+                    map.mapValues(values.data() + start, pixels.data(), lineLength, -100.0f, 0.0f);
+                    consume(pixels[0].getNativeARGB());
+                }
+            }));
+        }
+    }
+
+   #if JUCE_MODULE_AVAILABLE_juce_gui_basics
+    //==============================================================================
+    /** Building CIELCHThemes from pairs of random seeds, and writing them into a LookAndFeel */
+    void benchmarkThemes(const Settings& settings, Results& results)
+    {
+        const int numThemes = settings.quick ? 256 : 1024;
+        const std::vector<CIELCHColour> seeds = createTestColours(2 * numThemes);
+        LookAndFeel_V4 lookAndFeel;
+
+        results.add("theme", "build", "random seeds", numThemes, 1, timeFastestRun(settings, [&]
+        {
+            for (int i = 0; i < numThemes; ++i)
+                consume(CIELCHTheme(seeds[(size_t) (2 * i)], seeds[(size_t) (2 * i + 1)]).getColour(CIELCHTheme::text).getARGB());
+        }));
+
+        results.add("theme", "build + applyTo", "LookAndFeel_V4", numThemes, 1, timeFastestRun(settings, [&]
+        {
+            for (int i = 0; i < numThemes; ++i)
+            {
+                CIELCHTheme(seeds[(size_t) (2 * i)], seeds[(size_t) (2 * i + 1)]).applyTo(lookAndFeel);
+                consume(lookAndFeel.findColour(TextButton::textColourOffId).getARGB());
+            }
+        }));
+    }
+   #endif
+
+    //==============================================================================
+    /** Whole images, on all cores */
+    void benchmarkImages(const Settings& settings, Results& results)
+    {
+        struct Size { const char* name; int width, height; };
+
+        const Size sizes[] =
+        {
+            { "256x256",   256,  256  },
+            { "1024x1024", 1024, 1024 },
+            { "1080p",     1920, 1080 },
+            { "4K",        3840, 2160 },
+            { "8K",        7680, 4320 }
+        };
+
+        const CIELabPlaneTransform transform = CIELabPlaneTransform::hueRotation(0.1f)
+                                                   .followedBy(CIELabPlaneTransform::chromaMultiplication(0.8f));
+
+        const CIELCHToneCurve curve = CIELCHToneCurve::contrast(0.3f);
+        const CIELCHToneCurve chromaCurve = CIELCHToneCurve::levels(0.0f, 1.0f, 1.0f, 0.6f, 1.0f);
+
+        for (auto& size : sizes)
+        {
+            if (settings.quick && size.width > 4000)
+                continue;
+
+            const Image original = createTestImage(size.width, size.height);
+            const int64 numPixels = (int64) size.width * size.height;
+            const int numThreads = CIELCHParallel::getNumWorkers(size.width, size.height);
+            Image image = original.createCopy();
+
+            // the in-place operations start every run from the original pixels, so that no run
+            // times the accumulated result of the ones before
+            const auto restoreImage = [&] { copyPixels(original, image); };
+
+            for (auto precision : { CIELCHPrecision::exact, CIELCHPrecision::fast, CIELCHPrecision::fastest })
+            {
+                const String variant = String(size.name) + (precision == CIELCHPrecision::exact ? " exact"
+                                                          : precision == CIELCHPrecision::fast  ? " fast" : " fastest");
+
+                results.add("image", "CIELabPlaneTransform::applyTo", variant, numPixels, numThreads,
+                            timeFastestRun(settings, restoreImage, [&] { transform.applyTo(image, precision); }));
+
+                results.add("image", "CIELCHToneCurve::applyTo", variant, numPixels, numThreads,
+                            timeFastestRun(settings, restoreImage, [&] { curve.applyTo(image, &chromaCurve, precision); }));
+
+                results.add("image", "CIELCHBlend::blend", variant, numPixels, numThreads,
+                            timeFastestRun(settings, restoreImage, [&] { CIELCHBlend::blend(image, original, 0.5f, CIELCHBlendMode::all, Image(), precision); }));
+
+                CIELCHImageStatistics statistics;
+
+                results.add("image", "CIELCHImageStatistics::analyse", variant, numPixels, numThreads,
+                            timeFastestRun(settings, [&] { statistics.analyse(original, 0.02f, precision); }));
+
+                results.add("image", "CIELCHImageBuffer round trip", variant, numPixels, numThreads,
+                            timeFastestRun(settings, [&] { CIELCHImageBuffer(original, precision).writeTo(image, precision); }));
+            }
+
+            // the float operations don't convert colours, so they have no precision; like the
+            // Image operations, every run starts from the planes of the original
+            const CIELCHImageBuffer originalBuffer(original);
+            CIELCHImageBuffer buffer(size.width, size.height);
+            const auto restoreBuffer = [&] { copyPlanes(originalBuffer, buffer); };
+
+            results.add("image", "CIELCHImageBuffer::applyTransform", size.name, numPixels, numThreads,
+                        timeFastestRun(settings, restoreBuffer, [&] { buffer.applyTransform(transform); }));
+
+            results.add("image", "CIELCHImageBuffer::applyToneCurve", size.name, numPixels, numThreads,
+                        timeFastestRun(settings, restoreBuffer, [&] { buffer.applyToneCurve(curve, &chromaCurve); }));
+        }
+    }
+
+    //==============================================================================
+    /** A CIE Lab transform of flat artwork, converting each distinct colour once and every pixel */
+    void benchmarkUniqueColours(const Settings& settings, Results& results)
+    {
+        const CIELabPlaneTransform transform = CIELabPlaneTransform::hueRotation(0.1f)
+                                                   .followedBy(CIELabPlaneTransform::chromaMultiplication(0.8f));
+        const CIELCHConverter converter(CIELCHPrecision::exact);
+
+        const auto transformPixels = [&] (PixelARGB* pixels, int numPixels)
+        {
+            HeapBlock<float> L((size_t) numPixels), a((size_t) numPixels), b((size_t) numPixels);
+            converter.RGBtoCIELab(pixels, L, a, b, numPixels);
+            transform.transformPoints(a, b, numPixels);
+            converter.CIELabtoRGB(L, a, b, pixels, numPixels);
+        };
+
+        for (auto size : { Point<int>(1920, 1080), Point<int>(3840, 2160) })
+        {
+            const String variant = size.x < 3000 ? "1080p flat" : "4K flat";
+            const Image original = createFlatTestImage(size.x, size.y);
+            const int64 numPixels = (int64) size.x * size.y;
+            const int numThreads = CIELCHParallel::getNumWorkers(size.x, size.y);
+            Image image = original.createCopy();
+
+            // every run of both paths starts from the original artwork: the chroma multiplication
+            // would otherwise merge colours from run to run and shrink the number of distinct ones
+            const auto restoreImage = [&] { copyPixels(original, image); };
+
+            results.add("unique colours", "unique colours", variant, numPixels, numThreads,
+                        timeFastestRun(settings, restoreImage, [&] { CIELCHUniqueColours::applyTo(image, transformPixels); }));
+
+            results.add("unique colours", "dense", variant, numPixels, numThreads,
+                        timeFastestRun(settings, restoreImage, [&] { CIELCHUniqueColours::applyTo(image, transformPixels, 0); }));
+        }
+    }
+
+    //==============================================================================
+    /** The fast round trip of a 4K image on 1, 2, 4... threads */
+    void benchmarkThreadScaling(const Settings& settings, Results& results)
+    {
+        const int width = 3840, height = 2160;
+        const Image original = createTestImage(width, height);
+        Image image = original.createCopy();
+        const Image::BitmapData data(image, Image::BitmapData::readWrite);
+        const CIELCHConverter converter(CIELCHPrecision::fast);
+
+        auto roundTrip = [&] (int startRow, int endRow)
+        {
+            std::vector<float> L((size_t) width), C((size_t) width), H((size_t) width);
+
+            for (int y = startRow; y < endRow; ++y)
+            {
+                PixelARGB* line = reinterpret_cast<PixelARGB*>(data.getLinePointer(y));
+                converter.RGBtoCIELCH(line, L.data(), C.data(), H.data(), width);
+                converter.CIELCHtoRGB(L.data(), C.data(), H.data(), line, width);
+            }
+        };
+
+        Array<int> threadCounts;
+
+        for (int n = 1; n < SystemStats::getNumCpus(); n *= 2)
+            threadCounts.add(n);
+
+        threadCounts.add(SystemStats::getNumCpus());
+
+        // the round trip works in place, so every run starts again from the original pixels
+        for (int numThreads : threadCounts)
+        {
+            results.add("threads", "round trip fast 4K", String(numThreads) + " threads", (int64) width * height, numThreads,
+                        timeFastestRun(settings, [&] { copyPixels(original, image); }, [&]
+            {
+                std::vector<std::thread> threads;
+
+                for (int i = 1; i < numThreads; ++i)
+                    threads.emplace_back(roundTrip, (height * i) / numThreads, (height * (i + 1)) / numThreads);
+
+                roundTrip(0, height / numThreads);
+
+                for (auto& t : threads)
+                    t.join();
+            }));
+        }
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    Settings settings;
+    String outputFile;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const String argument(argv[i]);
+
+        if (argument == "--quick")
+        {
+            settings.quick = true;
+            settings.minimumSeconds = 0.05;
+            settings.numRuns = 3;
+        }
+        else if (argument == "--output" && i + 1 < argc)
+        {
+            outputFile = argv[++i];
+        }
+        else
+        {
+            std::cerr << "Usage: CIELCHBenchmark [--quick] [--output results.json]" << std::endl;
+            return 1;
+        }
+    }
+
+    Results results;
+    benchmarkColourFunctions(settings, results);
+    benchmarkLineConversions(settings, results);
+    benchmarkColourMaps(settings, results);
+   #if JUCE_MODULE_AVAILABLE_juce_gui_basics
+    benchmarkThemes(settings, results);
+   #endif
+    benchmarkImages(settings, results);
+    benchmarkUniqueColours(settings, results);
+    benchmarkThreadScaling(settings, results);
+
+    const String json = JSON::toString(results.toJSON());
+
+    if (outputFile.isEmpty())
+        std::cout << json << std::endl;
+    else if (! File::getCurrentWorkingDirectory().getChildFile(outputFile).replaceWithText(json))
+        return 1;
+
+    return 0;
+}
@@ -36,7 +36,6 @@ SOFTWARE.
 #define BLENDINGCOMPONENT_H_INCLUDED
 
 #include "../JuceLibraryCode/JuceHeader.h"
-#include "../../../module/CIELCHColour.h"
 
 
 class BlendingComponent : public Component
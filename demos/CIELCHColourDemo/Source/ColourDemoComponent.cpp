@@ -37,10 +37,11 @@ SOFTWARE.
 
 ColourDemoComponent::ColourDemoComponent()
 {
-    setSize(940, 920);
+    setSize(940, 1270);
     addAndMakeVisible(blenderExample);
     addAndMakeVisible(desaturationExample);
     addAndMakeVisible(geometryExample);
+    addAndMakeVisible(pickerExample);
 
     tooltip = new TooltipWindow();
     tooltip->setMillisecondsBeforeTipAppears(200);
@@ -68,5 +69,6 @@ void ColourDemoComponent::resized()
     blenderExample.setBounds(15, 80, getWidth() - 15, 135);
     desaturationExample.setBounds(15, 260, getWidth() - 15, 240);
     geometryExample.setBounds(15, 525, getWidth() - 15, 382);
+    pickerExample.setBounds(15, 930, getWidth() - 15, 330);
 }
 
@@ -36,10 +36,10 @@ SOFTWARE.
 #define DEMOCOMPONENT_H_INCLUDED
 
 #include "../JuceLibraryCode/JuceHeader.h"
-#include "../../../module/CIELCHColour.h"
 #include "BlendingComponent.h"
 #include "DesaturationComponent.h"
 #include "GeometryComponent.h"
+#include "PickerComponent.h"
 
 //==============================================================================
 /** Demo component showing a comparison between the CIE LCH colour space and the
@@ -60,6 +60,7 @@ private:
     BlendingComponent blenderExample;
     DesaturationComponent desaturationExample;
     GeometryComponent geometryExample;
+    PickerComponent pickerExample;
 
     ScopedPointer<TooltipWindow> tooltip;
     
@@ -77,6 +77,13 @@ void DesaturationComponent::resized()
     saturationSlider.setBounds(715, 40 - 5, 20, img.getHeight() + 30 + 8);
 }
 
+void DesaturationComponent::setMultipliers(double chromaMultiplier, double saturationMultiplier)
+{
+    chromaSlider.setValue(chromaMultiplier, NotificationType::dontSendNotification);
+    saturationSlider.setValue(saturationMultiplier, NotificationType::dontSendNotification);
+    repaint();
+}
+
 void DesaturationComponent::sliderValueChanged(Slider* /* slider */)
 {
     repaint();
@@ -37,7 +37,6 @@ SOFTWARE.
 
 
 #include "../JuceLibraryCode/JuceHeader.h"
-#include "../../../module/CIELCHColour.h"
 
 class DesaturationComponent : public Component,
                               public Slider::Listener
@@ -46,6 +45,9 @@ public:
 
     DesaturationComponent();
 
+    /** Sets both sliders, e.g. for rendering the component offscreen. */
+    void setMultipliers(double chromaMultiplier, double saturationMultiplier);
+
 private:
 
     void paint(Graphics& g) override;
@@ -103,6 +103,18 @@ void GeometryComponent::resized()
 
 }
 
+void GeometryComponent::setColourPlanes(int lchPlaneIndex, double lchValue, int hsvPlaneIndex, double hsvValue)
+{
+    lchChoice.setSelectedItemIndex(lchPlaneIndex, NotificationType::dontSendNotification);
+    hsvChoice.setSelectedItemIndex(hsvPlaneIndex, NotificationType::dontSendNotification);
+    lchSlider.setValue(lchValue, NotificationType::dontSendNotification);
+    hsvSlider.setValue(hsvValue, NotificationType::dontSendNotification);
+
+    // update the captions right away, without waiting for an asynchronous notification
+    comboBoxChanged(&lchChoice);
+    comboBoxChanged(&hsvChoice);
+}
+
 void GeometryComponent::sliderValueChanged(Slider* /* slider */)
 {
     repaint();
@@ -36,7 +36,6 @@ SOFTWARE.
 #define GEOMETRYCOMPONENT_H_INCLUDED
 
 #include "../JuceLibraryCode/JuceHeader.h"
-#include "../../../module/CIELCHColour.h"
 
 class GeometryComponent : public Component,
                           public Slider::Listener,
@@ -46,6 +45,12 @@ public:
 
     GeometryComponent();
 
+    /** Selects the colour planes and sets the sliders, e.g. for rendering the component offscreen.
+    The plane indices are the item indices of the ComboBoxes: L - C, C - H, L - H for CIE LCH,
+    and B - S, S - H, B - H for HSV.
+    */
+    void setColourPlanes(int lchPlaneIndex, double lchValue, int hsvPlaneIndex, double hsvValue);
+
 private:
     void paint(Graphics& g) override;
     void resized() override;
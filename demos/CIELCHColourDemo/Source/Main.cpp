@@ -34,6 +34,7 @@ SOFTWARE.
 
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "ColourDemoComponent.h"
+#include "RenderBenchmark.h"
 
 //==============================================================================
 class CIELCH_ColourApplication  : public JUCEApplication
@@ -47,10 +48,20 @@ public:
     bool moreThanOneInstanceAllowed() override       { return true; }
 
     //==============================================================================
-    void initialise (const String& /* commandLine */) override
+    void initialise (const String& commandLine) override
     {
         // This method is where you should put your application's initialisation code..
 
+        // headless mode: render the components offscreen and quit, see RenderBenchmark
+        const StringArray arguments = StringArray::fromTokens (commandLine, true);
+
+        if (arguments.contains ("--render-benchmark"))
+        {
+            setApplicationReturnValue (RenderBenchmark::run (arguments));
+            quit();
+            return;
+        }
+
         mainWindow = new MainWindow (getApplicationName());
    
     }
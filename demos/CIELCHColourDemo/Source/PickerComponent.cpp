@@ -0,0 +1,105 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+#include "PickerComponent.h"
+
+PickerComponent::PickerComponent()
+{
+    picker.setCurrentColour(CIELCHColour(Colours::orange), NotificationType::dontSendNotification);
+    picker.addChangeListener(this);
+    addAndMakeVisible(picker);
+
+    layoutChoice.addItem("L - C", 1 + (int) CIELCHColourPicker::Layout::lightnessChromaPlane);
+    layoutChoice.addItem("C - H", 1 + (int) CIELCHColourPicker::Layout::chromaHueWheel);
+    layoutChoice.setSelectedId(1 + (int) picker.getLayout(), NotificationType::dontSendNotification);
+    layoutChoice.setTooltip("Change the plane of the picker");
+    layoutChoice.addListener(this);
+    addAndMakeVisible(layoutChoice);
+}
+
+PickerComponent::~PickerComponent()
+{
+    picker.removeChangeListener(this);
+}
+
+void PickerComponent::paint(Graphics& g)
+{
+    g.setColour(Colours::black);
+    g.setFont(Font("Arial", 20, Font::plain));
+    g.drawText("CIE LCH colour picker. Colours outside of sRGB are faded, the line marks the edge of sRGB:", 0, 0, getWidth(), 25, Justification::centredLeft);
+
+    float L, C, H;
+    picker.getCurrentCIELCH(L, C, H);
+
+    const Rectangle<int> swatch(465, 95, 150, 100);
+    g.setColour(picker.getCurrentColour().getJuceColour());
+    g.fillRect(swatch);
+    g.setColour(Colours::darkgrey);
+    g.drawRect(swatch);
+
+    g.setColour(Colours::black);
+    g.setFont(Font("Arial", 16, Font::plain));
+    g.drawText("L = " + String(L, 2) + "   C = " + String(C, 2) + "   H = " + String(H, 2), 465, 205, 350, 20, Justification::centredLeft);
+    g.drawText(picker.getCurrentColour().getJuceColour().toDisplayString(false), 465, 225, 350, 20, Justification::centredLeft);
+
+    if (picker.isCurrentColourImaginary())
+    {
+        g.setColour(Colours::darkred);
+        g.drawText("Outside of sRGB: the swatch shows the clipped colour", 465, 245, 350, 20, Justification::centredLeft);
+    }
+}
+
+void PickerComponent::resized()
+{
+    layoutChoice.setBounds(465, 40, 100, 35);
+    picker.setBounds(0, 40, 440, 290);
+}
+
+void PickerComponent::setPickerLayout(int layoutIndex)
+{
+    layoutChoice.setSelectedItemIndex(layoutIndex, NotificationType::dontSendNotification);
+
+    // switch right away, without waiting for an asynchronous notification
+    comboBoxChanged(&layoutChoice);
+}
+
+void PickerComponent::changeListenerCallback(ChangeBroadcaster* /* source */)
+{
+    repaint(465, 90, getWidth() - 465, getHeight() - 90);
+}
+
+void PickerComponent::comboBoxChanged(ComboBox* comboBox)
+{
+    picker.setLayout(static_cast<CIELCHColourPicker::Layout> (comboBox->getSelectedId() - 1));
+}
@@ -0,0 +1,359 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+
+#include "RenderBenchmark.h"
+#include "BlendingComponent.h"
+#include "DesaturationComponent.h"
+#include "GeometryComponent.h"
+#include "PickerComponent.h"
+#include <functional>
+#include <iostream>
+
+namespace
+{
+    /** One component with fixed settings */
+    struct Scene
+    {
+        String name;
+        int width, height;
+        std::function<Component* ()> create;
+    };
+
+    Array<Scene> createScenes()
+    {
+        // the sizes which ColourDemoComponent gives the components
+        const int width = 925;
+        Array<Scene> scenes;
+
+        scenes.add({ "blending", width, 135, [] { return new BlendingComponent(); } });
+
+        const struct { const char* name; double chroma, saturation; } desaturations[] =
+        {
+            { "desaturation-half", 0.5, 0.5 },
+            { "desaturation-grey", 0.0, 0.0 },
+            { "desaturation-none", 1.0, 1.0 }
+        };
+
+        for (auto& d : desaturations)
+        {
+            const double chroma = d.chroma, saturation = d.saturation;
+
+            scenes.add({ d.name, width, 240, [chroma, saturation]
+            {
+                DesaturationComponent* c = new DesaturationComponent();
+                c->setMultipliers(chroma, saturation);
+                return c;
+            }});
+        }
+
+        const struct { const char* name; int lchPlane; double lchValue; int hsvPlane; double hsvValue; } geometries[] =
+        {
+            { "geometry-lc-bs", 0, 0.77, 0, 0.77 },
+            { "geometry-ch-sh", 1, 0.77, 1, 0.77 },
+            { "geometry-lh-bh", 2, 0.5,  2, 0.5  },
+            { "geometry-ch-sh-dark", 1, 0.3, 1, 0.3 }
+        };
+
+        for (auto& g : geometries)
+        {
+            const int lchPlane = g.lchPlane, hsvPlane = g.hsvPlane;
+            const double lchValue = g.lchValue, hsvValue = g.hsvValue;
+
+            scenes.add({ g.name, width, 382, [lchPlane, lchValue, hsvPlane, hsvValue]
+            {
+                GeometryComponent* c = new GeometryComponent();
+                c->setColourPlanes(lchPlane, lchValue, hsvPlane, hsvValue);
+                return c;
+            }});
+        }
+
+        return scenes;
+    }
+
+    //==============================================================================
+    /** Paints the component like ColourDemoComponent does, on a white background */
+    void render(Component& component, Image& image)
+    {
+        Graphics g(image);
+        g.fillAll(Colours::white);
+        component.paintEntireComponent(g, false);
+    }
+
+    /** Returns the time in milliseconds, below which the given fraction of the sorted times are */
+    double percentile(const Array<double>& sortedTimes, double fraction)
+    {
+        const int index = roundToInt(fraction * (sortedTimes.size() - 1));
+        return sortedTimes[index];
+    }
+
+    /** Prints one line of the table, and sorts the times for it */
+    void printTimes(const String& name, Array<double>& times, const String& golden)
+    {
+        times.sort();
+
+        std::cout << name.paddedRight(' ', 20)
+                  << "  " << String(times.getFirst(), 2).paddedLeft(' ', 7)
+                  << "  " << String(percentile(times, 0.5), 2).paddedLeft(' ', 7)
+                  << "  " << String(percentile(times, 0.9), 2).paddedLeft(' ', 7)
+                  << "  " << String(percentile(times, 0.99), 2).paddedLeft(' ', 7)
+                  << "  " << String(times.getLast(), 2).paddedLeft(' ', 7)
+                  << "  " << golden << std::endl;
+    }
+
+    //==============================================================================
+    /** Dispatches messages until the picker has received the plane for its current colour.
+    @returns false if that can't happen, because modal loops are disabled, or took over 5 seconds.
+    */
+    bool waitForPlane(CIELCHColourPicker& picker)
+    {
+       #if JUCE_MODAL_LOOPS_PERMITTED
+        const uint32 timeout = Time::getMillisecondCounter() + 5000;
+
+        while (! picker.isPlaneUpToDate())
+        {
+            if (Time::getMillisecondCounter() > timeout)
+                return false;
+
+            MessageManager::getInstance()->runDispatchLoopUntil(1);
+        }
+       #endif
+
+        return picker.isPlaneUpToDate();
+    }
+
+    /** Times the steps of two drags over the picker, each a colour change and a paint:
+    one of the cursor over the plane, which only paints the cached plane, and one of the strip,
+    which also waits for the new plane from the render thread.
+    */
+    void timePickerDrags(int numIterations)
+    {
+        PickerComponent component;
+        component.setBounds(0, 0, 925, 330);
+
+        CIELCHColourPicker& picker = component.getPicker();
+        Image image(Image::ARGB, component.getWidth(), component.getHeight(), true, SoftwareImageType());
+
+        picker.setCurrentCIELCH(0.6f, 0.3f, 0.1f, dontSendNotification);
+
+        if (! waitForPlane(picker))
+        {
+            std::cout << "picker drags: the plane isn't rendered, this needs JUCE_MODAL_LOOPS_PERMITTED" << std::endl;
+            return;
+        }
+
+        render(component, image);
+
+        Array<double> cursorTimes, stripTimes;
+
+        for (int i = 0; i < numIterations; ++i)
+        {
+            // along a diagonal of the lightness-chroma plane, at the hue of the strip
+            const float t = (float) (i + 1) / (float) numIterations;
+
+            const int64 start = Time::getHighResolutionTicks();
+            picker.setCurrentCIELCH(0.2f + 0.6f * t, 0.5f * t, 0.1f, dontSendNotification);
+            render(component, image);
+            cursorTimes.add(Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start) * 1000.0);
+        }
+
+        for (int i = 0; i < numIterations; ++i)
+        {
+            // down the hue strip, so that every step renders a new plane
+            const float t = (float) (i + 1) / (float) numIterations;
+
+            const int64 start = Time::getHighResolutionTicks();
+            picker.setCurrentCIELCH(0.6f, 0.3f, 0.1f + 0.8f * t, dontSendNotification);
+
+            if (! waitForPlane(picker))
+            {
+                std::cout << "picker drags: the plane render timed out" << std::endl;
+                return;
+            }
+
+            render(component, image);
+            stripTimes.add(Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start) * 1000.0);
+        }
+
+        printTimes("picker-cursor-drag", cursorTimes, "-");
+        printTimes("picker-strip-drag", stripTimes, "-");
+    }
+
+    //==============================================================================
+    struct Comparison
+    {
+        bool found = false;
+        int maxDifference = 0;
+        int numDifferentPixels = 0;
+    };
+
+    Comparison compare(const Image& image, const Image& golden, int tolerance)
+    {
+        Comparison result;
+
+        if (! golden.isValid() || golden.getWidth() != image.getWidth() || golden.getHeight() != image.getHeight())
+            return result;
+
+        result.found = true;
+
+        const Image::BitmapData actualData(image, Image::BitmapData::readOnly);
+        const Image::BitmapData goldenData(golden, Image::BitmapData::readOnly);
+
+        for (int y = 0; y < image.getHeight(); ++y)
+        {
+            for (int x = 0; x < image.getWidth(); ++x)
+            {
+                const Colour a = actualData.getPixelColour(x, y);
+                const Colour b = goldenData.getPixelColour(x, y);
+
+                const int difference = jmax(std::abs(a.getRed() - b.getRed()),
+                                            std::abs(a.getGreen() - b.getGreen()),
+                                            std::abs(a.getBlue() - b.getBlue()),
+                                            std::abs(a.getAlpha() - b.getAlpha()));
+
+                result.maxDifference = jmax(result.maxDifference, difference);
+
+                if (difference > tolerance)
+                    ++result.numDifferentPixels;
+            }
+        }
+
+        return result;
+    }
+
+    bool writePNG(const Image& image, const File& file)
+    {
+        file.deleteFile();
+        FileOutputStream stream(file);
+
+        PNGImageFormat png;
+        return stream.openedOk() && png.writeImageToStream(image, stream);
+    }
+}
+
+//==============================================================================
+int RenderBenchmark::run(const StringArray& arguments)
+{
+    int numIterations = 20;
+    int tolerance = 2;
+    bool updateGolden = false;
+    File goldenDirectory;
+
+    for (int i = 0; i < arguments.size(); ++i)
+    {
+        const String argument(arguments[i].unquoted());
+
+        if (argument == "--iterations" && i + 1 < arguments.size())
+            numIterations = jmax(1, arguments[++i].getIntValue());
+        else if (argument == "--tolerance" && i + 1 < arguments.size())
+            tolerance = jmax(0, arguments[++i].getIntValue());
+        else if (argument == "--golden" && i + 1 < arguments.size())
+            goldenDirectory = File::getCurrentWorkingDirectory().getChildFile(arguments[++i].unquoted());
+        else if (argument == "--update-golden")
+            updateGolden = true;
+    }
+
+    if (updateGolden && goldenDirectory == File())
+    {
+        std::cerr << "--update-golden needs a --golden directory" << std::endl;
+        return 1;
+    }
+
+    bool allMatch = true;
+
+    std::cout << "scene                 min ms   p50 ms   p90 ms   p99 ms   max ms   golden" << std::endl;
+
+    for (auto& scene : createScenes())
+    {
+        ScopedPointer<Component> component(scene.create());
+        component->setBounds(0, 0, scene.width, scene.height);
+
+        Image image(Image::ARGB, scene.width, scene.height, true, SoftwareImageType());
+
+        // one untimed call, which loads the fonts and images
+        render(*component, image);
+
+        Array<double> times;
+
+        for (int i = 0; i < numIterations; ++i)
+        {
+            const int64 start = Time::getHighResolutionTicks();
+            render(*component, image);
+            times.add(Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start) * 1000.0);
+        }
+
+        String golden = "-";
+
+        if (goldenDirectory != File())
+        {
+            const File goldenFile = goldenDirectory.getChildFile(scene.name + ".png");
+
+            if (updateGolden)
+            {
+                goldenDirectory.createDirectory();
+                golden = writePNG(image, goldenFile) ? "written" : "write failed";
+            }
+            else
+            {
+                const Comparison comparison = compare(image, ImageFileFormat::loadFrom(goldenFile), tolerance);
+
+                if (! comparison.found)
+                {
+                    golden = "missing";
+                    allMatch = false;
+                }
+                else if (comparison.numDifferentPixels > 0)
+                {
+                    // keep the rendered image, so that it can be compared by eye
+                    const File actualFile = File::getSpecialLocation(File::tempDirectory).getChildFile(scene.name + "-actual.png");
+                    writePNG(image, actualFile);
+
+                    golden = String(comparison.numDifferentPixels) + " pixels differ by up to "
+                               + String(comparison.maxDifference) + ", see " + actualFile.getFullPathName();
+                    allMatch = false;
+                }
+                else
+                {
+                    golden = "match (max difference " + String(comparison.maxDifference) + ")";
+                }
+            }
+        }
+
+        printTimes(scene.name, times, golden);
+    }
+
+    timePickerDrags(numIterations);
+
+    return allMatch ? 0 : 1;
+}
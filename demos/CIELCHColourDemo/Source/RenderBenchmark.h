@@ -0,0 +1,77 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+
+#ifndef RENDERBENCHMARK_H_INCLUDED
+#define RENDERBENCHMARK_H_INCLUDED
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/** Renders the demo components offscreen, times their paint() calls and compares the
+    results with golden images.
+
+    The application runs this instead of opening its window, when it is started with
+    --render-benchmark:
+
+    CIELCHColourDemo --render-benchmark [--iterations 20] [--golden dir] [--update-golden] [--tolerance 2]
+
+    --iterations     number of timed paint() calls per scene
+    --golden         directory with one PNG per scene; without it, nothing is compared
+    --update-golden  writes the rendered images into the golden directory instead of comparing
+    --tolerance      the maximum difference of a colour channel which is still a match
+
+    Each scene is a component with fixed slider and ComboBox settings, painted into an image
+    with the software renderer. After the scenes, the steps of two drags over the colour picker
+    are timed, each a colour change and a paint: one of the cursor over the plane, and one of the
+    hue strip, which includes waiting for the new plane from the picker's render thread. The
+    times are reported as percentiles in milliseconds. Font
+    rendering differs between platforms, so golden images should be created on the machine
+    (or at least the operating system) on which they are checked.
+*/
+class RenderBenchmark
+{
+public:
+
+    /** Runs the benchmark and returns the exit code: 0 if all golden images match. */
+    static int run(const StringArray& arguments);
+
+private:
+
+    RenderBenchmark() = delete;
+};
+
+
+
+#endif  // RENDERBENCHMARK_H_INCLUDED
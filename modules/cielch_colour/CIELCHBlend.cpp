@@ -0,0 +1,193 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+namespace
+{
+    /** Below this chroma (in the range 0...1) the hue of a colour is treated as meaningless */
+    const float minChromaForHue = 0.001f;
+
+    /** The hue reached after going the fraction t of the shorter way from hue to otherHue */
+    inline float interpolateHue(float hue, float otherHue, float t) noexcept
+    {
+        float difference = otherHue - hue;
+        difference -= std::floor(difference + 0.5f);
+
+        const float result = hue + t * difference;
+        return result - std::floor(result);
+    }
+
+    /** Blends source (or the colour, if source is nullptr) into destination */
+    void blendImage(Image& destination, const Image* source, PixelARGB colour, float amount,
+                    CIELCHBlendMode mode, const Image& weights, CIELCHPrecision precision)
+    {
+        if (!destination.isValid() || destination.getFormat() == Image::SingleChannel)
+            return;
+
+        // the images must have the same size
+        jassert(source == nullptr || source->getBounds() == destination.getBounds());
+        jassert(!weights.isValid() || weights.getBounds() == destination.getBounds());
+
+        if ((source != nullptr && (!source->isValid() || source->getBounds() != destination.getBounds()))
+             || (weights.isValid() && weights.getBounds() != destination.getBounds()))
+            return;
+
+        amount = jlimit(0.0f, 1.0f, amount);
+
+        const Image::BitmapData data(destination, Image::BitmapData::readWrite);
+        const CIELCHConverter converter(precision);
+        const int width = data.width;
+
+        // the bitmap data is created once and shared by all workers. The source can be the
+        // destination itself, which works because every line is read before it is written.
+        std::unique_ptr<Image::BitmapData> sourceData, weightsData;
+
+        if (source != nullptr)
+            sourceData.reset(new Image::BitmapData(*source, Image::BitmapData::readOnly));
+
+        if (weights.isValid())
+            weightsData.reset(new Image::BitmapData(weights, Image::BitmapData::readOnly));
+
+        float colourL = 0.0f, colourC = 0.0f, colourH = 0.0f;
+        converter.RGBtoCIELCH(&colour, &colourL, &colourC, &colourH, 1);
+
+        CIELCHParallel::forEachRowRange(width, data.height, [&](int startRow, int endRow, int)
+        {
+            HeapBlock<PixelARGB> pixels((size_t) width), otherPixels((size_t) width), weightPixels;
+            HeapBlock<float> L((size_t) width), C((size_t) width), H((size_t) width);
+            HeapBlock<float> otherL((size_t) width), otherC((size_t) width), otherH((size_t) width);
+            HeapBlock<float> colourWeights((size_t) width);
+
+            if (weightsData != nullptr)
+                weightPixels.malloc((size_t) width);
+
+            if (sourceData == nullptr)
+            {
+                for (int x = 0; x < width; ++x)
+                {
+                    otherPixels[x] = colour;
+                    otherL[x] = colourL;
+                    otherC[x] = colourC;
+                    otherH[x] = colourH;
+                }
+            }
+
+            for (int y = startRow; y < endRow; ++y)
+            {
+                CIELCHImageLine::read(data, y, pixels);
+
+                if (sourceData != nullptr)
+                {
+                    CIELCHImageLine::read(*sourceData, y, otherPixels);
+                    converter.RGBtoCIELCH(otherPixels, otherL, otherC, otherH, width);
+                }
+
+                if (weightsData != nullptr)
+                    CIELCHImageLine::read(*weightsData, y, weightPixels);
+
+                // alpha is blended linearly, and each colour is weighted by its alpha
+                for (int x = 0; x < width; ++x)
+                {
+                    const float weight = weightsData != nullptr ? amount * (float) weightPixels[x].getAlpha() * (1.0f / 255.0f)
+                                                                : amount;
+                    const float alpha = (float) pixels[x].getAlpha();
+                    const float otherAlpha = (float) otherPixels[x].getAlpha();
+                    const float newAlpha = alpha + weight * (otherAlpha - alpha);
+
+                    colourWeights[x] = newAlpha > 0.0f ? jmin(1.0f, weight * otherAlpha / newAlpha) : 0.0f;
+                    pixels[x].setAlpha((uint8) roundToInt(newAlpha));
+                }
+
+                converter.RGBtoCIELCH(pixels, L, C, H, width);
+                CIELCHBlend::blendCIELCH(L, C, H, otherL, otherC, otherH, colourWeights, width, mode);
+                converter.CIELCHtoRGB(L, C, H, pixels, width);
+                CIELCHImageLine::write(data, y, pixels);
+            }
+        });
+    }
+}
+
+//==============================================================================
+void CIELCHBlend::blend(Image& destination, const Image& source, float amount,
+                        CIELCHBlendMode mode, const Image& weights, CIELCHPrecision precision)
+{
+    blendImage(destination, &source, PixelARGB(), amount, mode, weights, precision);
+}
+
+void CIELCHBlend::blend(Image& destination, Colour colour, float amount,
+                        CIELCHBlendMode mode, const Image& weights, CIELCHPrecision precision)
+{
+    PixelARGB pixel(colour.getPixelARGB());
+    pixel.unpremultiply();
+
+    blendImage(destination, nullptr, pixel, amount, mode, weights, precision);
+}
+
+void CIELCHBlend::blendCIELCH(float* L, float* C, float* H,
+                              const float* otherL, const float* otherC, const float* otherH,
+                              const float* weights, int numValues, CIELCHBlendMode mode) noexcept
+{
+    // the mode is checked outside the loops, so that the compiler can vectorise each of them
+    switch (mode)
+    {
+        case CIELCHBlendMode::all:
+            for (int i = 0; i < numValues; ++i)
+            {
+                // a grey colour takes the hue of the other one, and doesn't change the other one's hue
+                const float hue = interpolateHue(H[i], otherH[i], otherC[i] < minChromaForHue ? 0.0f : weights[i]);
+                H[i] = C[i] < minChromaForHue ? otherH[i] : hue;
+                L[i] += weights[i] * (otherL[i] - L[i]);
+                C[i] += weights[i] * (otherC[i] - C[i]);
+            }
+            break;
+
+        case CIELCHBlendMode::lightness:
+            for (int i = 0; i < numValues; ++i)
+                L[i] += weights[i] * (otherL[i] - L[i]);
+            break;
+
+        case CIELCHBlendMode::chroma:
+            for (int i = 0; i < numValues; ++i)
+                C[i] += weights[i] * (otherC[i] - C[i]);
+            break;
+
+        case CIELCHBlendMode::hue:
+            for (int i = 0; i < numValues; ++i)
+                H[i] = otherC[i] < minChromaForHue ? H[i] : interpolateHue(H[i], otherH[i], weights[i]);
+            break;
+
+        default:
+            jassertfalse;
+            break;
+    }
+}
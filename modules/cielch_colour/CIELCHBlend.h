@@ -0,0 +1,111 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+#ifndef CIELCHBlend_H_INCLUDED
+#define CIELCHBlend_H_INCLUDED
+
+//==============================================================================
+/** Which components of CIE LCH are blended by CIELCHBlend. The others are kept. */
+enum class CIELCHBlendMode
+{
+    all,        /**< Lightness, chroma and hue, i.e. a normal crossfade in CIE LCH. */
+    lightness,  /**< Only the lightness, like the "luminosity" blend mode of image editors. */
+    chroma,     /**< Only the chroma, like the "saturation" blend mode of image editors. */
+    hue         /**< Only the hue, like the "hue" blend mode of image editors. */
+};
+
+//==============================================================================
+/**
+Blends two images, or an image and a colour, in CIE LCH.
+
+Like in the blending demo, the hue is interpolated along the shorter way around the colour
+circle, which gives smoother transitions than blending in RGB or HSV. The hue of grey pixels
+(with practically no chroma) is meaningless, so blending with a grey pixel keeps the hue of the
+other pixel instead of sweeping through unrelated hues.
+
+Alpha is blended linearly, and the colours are weighted by their alpha. So a transparent pixel
+contributes nothing to the colour, the same way blending premultiplied RGB pixels works.
+
+The weight can be global, or per pixel, taken from the alpha channel of a weights image (e.g. a
+SingleChannel mask) and multiplied by the global weight. The work is split over all CPU cores.
+For interactive use (e.g. crossfades of 1080p frames at 60 fps), use CIELCHPrecision::fast.
+
+Here an example on how to use the class:
+@code
+// 30% of the way from frame to nextFrame
+CIELCHBlend::blend(frame, nextFrame, 0.3f, CIELCHBlendMode::all, Image(), CIELCHPrecision::fast);
+
+// tint an image with the hue of orange
+CIELCHBlend::blend(img, Colours::orange, 1.0f, CIELCHBlendMode::hue);
+@endcode
+*/
+class CIELCHBlend
+{
+public:
+
+    /** Blends source into destination.
+    @param destination = the image to blend into. It must have the same size as source.
+    @param source = the image to blend in
+    @param amount = the global weight of source, in the range 0...1
+    @param mode = which components are blended, see CIELCHBlendMode
+    @param weights = if valid, the alpha of each of its pixels multiplies amount for the
+                     corresponding pixel. It must have the same size as destination.
+    @param precision = the precision of the colour conversions, see CIELCHPrecision. By default
+                       the one of CIELCHConverter::getDefaultPrecision().
+    */
+    static void blend(Image& destination, const Image& source, float amount,
+                      CIELCHBlendMode mode = CIELCHBlendMode::all, const Image& weights = Image(),
+                      CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision());
+
+    /** Blends a colour into destination.
+    @see blend(Image&, const Image&, float, CIELCHBlendMode, const Image&, CIELCHPrecision)
+    */
+    static void blend(Image& destination, Colour colour, float amount,
+                      CIELCHBlendMode mode = CIELCHBlendMode::all, const Image& weights = Image(),
+                      CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision());
+
+    /** Blends numValues CIE LCH values (in the range 0...1) with other values in place.
+    weights[i] is the weight of the other value i, in the range 0...1. It doesn't allocate memory.
+    */
+    static void blendCIELCH(float* L, float* C, float* H,
+                            const float* otherL, const float* otherC, const float* otherH,
+                            const float* weights, int numValues, CIELCHBlendMode mode) noexcept;
+
+private:
+
+    CIELCHBlend() = delete;
+};
+
+
+#endif  // CIELCHBlend_H_INCLUDED
@@ -0,0 +1,113 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+//==============================================================================
+CIELCHColour CIELCHColour::withCIELightness(float newLightness, bool& imaginary,
+                                            CIELCHPrecision precision) const noexcept
+{
+    CIELCH_COUNT_CALL(withCIELightness);
+
+    float L, C, H;
+    this->getCIELCH(L, C, H, precision);
+    return fromCIELCH(newLightness, C, H, this->getJuceColour().getFloatAlpha(), imaginary, precision);
+}
+
+CIELCHColour CIELCHColour::withCIEChroma(float newChroma, bool& imaginary,
+                                         CIELCHPrecision precision) const noexcept
+{
+    CIELCH_COUNT_CALL(withCIEChroma);
+
+    float L, C, H;
+    this->getCIELCH(L, C, H, precision);
+    return fromCIELCH(L, newChroma, H, this->getJuceColour().getFloatAlpha(), imaginary, precision);
+}
+
+CIELCHColour CIELCHColour::withCIEHue(float newHue, bool& imaginary,
+                                      CIELCHPrecision precision) const noexcept
+{
+    CIELCH_COUNT_CALL(withCIEHue);
+
+    float L, C, H;
+    this->getCIELCH(L, C, H, precision);
+    return fromCIELCH(L, C, newHue, this->getJuceColour().getFloatAlpha(), imaginary, precision);
+}
+
+CIELCHColour CIELCHColour::withMultipliedCIELightness(float multiplier, bool& imaginary,
+                                                      CIELCHPrecision precision) const noexcept
+{
+    CIELCH_COUNT_CALL(withMultipliedCIELightness);
+
+    float L, C, H;
+    this->getCIELCH(L, C, H, precision);
+    return fromCIELCH(L * multiplier, C, H, this->getJuceColour().getFloatAlpha(), imaginary, precision);
+}
+
+CIELCHColour CIELCHColour::withMultipliedCIEChroma(float multiplier, bool& imaginary,
+                                                   CIELCHPrecision precision) const noexcept
+{
+    CIELCH_COUNT_CALL(withMultipliedCIEChroma);
+
+    float L, C, H;
+    this->getCIELCH(L, C, H, precision);
+    return fromCIELCH(L, C * multiplier, H, this->getJuceColour().getFloatAlpha(), imaginary, precision);
+}
+
+CIELCHColour CIELCHColour::withRotatedCIEHue(float amountToRotate, bool& imaginary,
+                                             CIELCHPrecision precision) const noexcept
+{
+    CIELCH_COUNT_CALL(withRotatedCIEHue);
+
+    float L, C, H;
+    this->getCIELCH(L, C, H, precision);
+    return fromCIELCH(L, C, H + amountToRotate, this->getJuceColour().getFloatAlpha(), imaginary, precision);
+}
+
+//==============================================================================
+CIELCHColour CIELCHColour::CIELighter(bool& imaginary, float amountBrighter, CIELCHPrecision precision) const noexcept
+{
+    CIELCH_COUNT_CALL(CIELighter);
+
+    amountBrighter = 1.0f / (1.0f + amountBrighter);
+    float newLightness = 1.0f - (amountBrighter * (1.0f - getCIELightness(precision)));
+    return withCIELightness(newLightness, imaginary, precision);
+}
+
+CIELCHColour CIELCHColour::CIEDarker(bool& imaginary, float amountDarker, CIELCHPrecision precision) const noexcept
+{
+    CIELCH_COUNT_CALL(CIEDarker);
+
+    amountDarker = 1.0f / (1.0f + amountDarker);
+    float newLightness = amountDarker * getCIELightness(precision);
+    return withCIELightness(newLightness, imaginary, precision);
+}
@@ -34,9 +34,6 @@ SOFTWARE.
 #ifndef CIELCHColour_H_INCLUDED
 #define CIELCHColour_H_INCLUDED
 
-#include "../JuceLibraryCode/JuceHeader.h"
-#include <memory.h>
-
 //==============================================================================
 /**
 This class extends the JUCE Colour class by adding support for the CIE LCH perceptual colour space. 
@@ -71,6 +68,19 @@ CIELCHColour newColour  = CIELCHColour::fromHSV(h, s,  v);
 CIELCHColour newColour2 = Colours::yellow;
 @endcode
 
+The member functions convert at the precision of CIELCHConverter::getDefaultPrecision(), which
+is exact unless CIELCH_DEFAULT_PRECISION or CIELCHConverter::setDefaultPrecision change it, or
+at the CIELCHPrecision passed as their last argument. The static conversions (RGBtoCIELCH,
+CIELCHtoRGB and the others) are always exact.
+
+None of the functions of this class allocate memory: the colour is stored by value, and the
+conversions only use the stack and static tables. So they can be used where allocations must be
+avoided, e.g. in audio plug-ins. The same holds for the line conversions of CIELCHConversion and
+CIELCHConverter, and for CIELabPlaneTransform::apply. Only the first CIELCHConverter may allocate,
+when it asks JUCE for the CPU features (see CIELCHKernels); create one at start-up to avoid this.
+Functions which work on whole images (e.g. CIELabPlaneTransform::applyTo) do allocate.
+The CIELCHAccuracy tool checks this guarantee, by counting all allocations inside these calls.
+
 */
 class CIELCHColour
 {
@@ -141,7 +151,7 @@ public:
         float alpha) noexcept;
 
     /** Creates a colour using a PixelARGB object. This function assumes that the argb pixel is
-    not premultiplied.
+    not premultiplied. Pixels of ARGB images are premultiplied, use CIELCHImageLine to read them.
     */
     CIELCHColour(PixelARGB argb) noexcept;
 
@@ -164,7 +174,7 @@ public:
     //==============================================================================
 
     /** get the base JUCE colour, which this object works with */
-    Colour getJuceColour() const; 
+    Colour getJuceColour() const noexcept;
 
     /** Create the colour from the CIE LCH colour space.
     The CIE LCH colour space is a colour space, which corresponds to
@@ -175,35 +185,43 @@ public:
     These "imaginary" colours cannot be represented by RGB colours.
     Therefore certain LCH colours cannot be converted to a RGB colour.
     In such a case, the returned RGB colour is the closest match to the CIE LCH colour. And
-    the parameter "imaginary" is set to true.
+    the parameter "imaginary" is set to true. Colours which are less than half an 8-bit step
+    outside of sRGB are not imaginary, so every sRGB colour survives the round trip through
+    CIE LCH without being reported as imaginary.
 
     @param[in] L = lightness in the range [0...1]
     @param[in] C = chroma, relative saturation in the range [0...1]
     @param[in] H = hue in the range [0...1]
     @param[in] alpha = the alpha value for the colour.
     @param[out] imaginary = true if the LCH colour is imaginary (see above). False otherwise.
+    @param[in] precision = the precision of the conversion, see CIELCHPrecision. Like in all
+                           functions of this class, it defaults to
+                           CIELCHConverter::getDefaultPrecision().
     */
-    static CIELCHColour fromCIELCH(float L, float C, float H, float alpha, bool& imaginary) noexcept;
+    static CIELCHColour fromCIELCH(float L, float C, float H, float alpha, bool& imaginary,
+                                   CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision()) noexcept;
 
     /** Returns the CIE lightness component.
     The value is in the range 0...1
     */
-    float getCIELightness() const noexcept;
+    float getCIELightness(CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision()) const noexcept;
 
     /** Returns the CIE chroma/saturation component.
     The value is in the range 0...1
     */
-    float getCIEChroma() const noexcept;
+    float getCIEChroma(CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision()) const noexcept;
 
     /** Returns the CIE hue component.
     The value is in the range 0...1
     */
-    float getCIEHue() const noexcept;
+    float getCIEHue(CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision()) const noexcept;
 
     /** Returns the CIE lightness, chroma/saturation and hue.
     All values are in the range 0...1.
+    With CIELCH_ENABLE_COLOUR_CACHE the values of exact conversions are looked up in
+    CIELCHColourCache first.
     */
-    void getCIELCH(float& L, float& C, float& H) const noexcept;
+    void getCIELCH(float& L, float& C, float& H, CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision()) const noexcept;
 
     //==============================================================================
     /** Returns a copy of this colour with a different CIE brightness.
@@ -211,19 +229,22 @@ public:
     @see CIELighter, CIEDarker, withMultipliedCIELightness
     @see fromCIELCH for a better explanation on imaginary.
     */
-    CIELCHColour withCIELightness(float newLightness, bool& imaginary) const noexcept;
+    CIELCHColour withCIELightness(float newLightness, bool& imaginary,
+                                  CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision()) const noexcept;
 
     /** Returns a copy of this colour with a different CIE chroma/saturation.
     If the returned colour is an imaginary colour, then the "imaginary" parameter is set to true.
     @see fromCIELCH for a better explanation on imaginary.
     */
-    CIELCHColour withCIEChroma(float newChroma, bool& imaginary) const noexcept;
+    CIELCHColour withCIEChroma(float newChroma, bool& imaginary,
+                               CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision()) const noexcept;
 
     /** Returns a copy of this colour with a different CIE hue.
     If the returned colour is an imaginary colour, then the "imaginary" parameter is set to true.
     @see fromCIELCH for a better explanation on imaginary.
     */
-    CIELCHColour withCIEHue(float newHue, bool& imaginary) const noexcept;
+    CIELCHColour withCIEHue(float newHue, bool& imaginary,
+                            CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision()) const noexcept;
 
     /** Returns a copy of this colour with its CIE Lightness multiplied by the given value.
     The new colour's brightness is (this->getCIELightness() * multiplier)
@@ -234,7 +255,8 @@ public:
     lightness and chroma to zero. If you only set lightness to zero, the colour might still be
     visible.
     */
-    CIELCHColour withMultipliedCIELightness(float amount, bool& imaginary) const noexcept;
+    CIELCHColour withMultipliedCIELightness(float amount, bool& imaginary,
+                                            CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision()) const noexcept;
 
     /** Returns a copy of this colour with its CIE chroma/saturation multiplied by the given value.
     The new colour's chroma is (this->getCIEChroma() * multiplier)
@@ -243,7 +265,8 @@ public:
     @see withMultipliedCIEChroma, withRotatedCIEHue
     @see fromCIELCH for a better explanation on imaginary.
     */
-    CIELCHColour withMultipliedCIEChroma(float multiplier, bool& imaginary) const noexcept;
+    CIELCHColour withMultipliedCIEChroma(float multiplier, bool& imaginary,
+                                         CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision()) const noexcept;
 
     /** Returns a copy of this colour with its CIE hue rotated.
     The new colour's hue is ((this->getCIEHue() + amountToRotate) % 1.0)
@@ -251,7 +274,8 @@ public:
     @see withMultipliedCIELightness, withMultipliedCIEChroma
     @see fromCIELCH for a better explanation on imaginary.
     */
-    CIELCHColour withRotatedCIEHue(float amountToRotate, bool& imaginary) const noexcept;
+    CIELCHColour withRotatedCIEHue(float amountToRotate, bool& imaginary,
+                                    CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision()) const noexcept;
 
 
     //==============================================================================
@@ -262,7 +286,8 @@ public:
     @see fromCIELCH for a better explanation on imaginary.
     @see withMultipliedCIELightness
     */
-    CIELCHColour CIELighter(bool& imaginary, float amountBrighter = 0.4f) const noexcept;
+    CIELCHColour CIELighter(bool& imaginary, float amountBrighter = 0.4f,
+                            CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision()) const noexcept;
 
     /** Returns a darker version of this colour.
     @param amountDarker     how much darker to make it - a value from 0 to 1.0 where 0 is
@@ -274,7 +299,8 @@ public:
     @see fromCIELCH for a better explanation on imaginary.
     @see withMultipliedCIELightness
     */
-    CIELCHColour CIEDarker(bool& imaginary, float amountDarker = 0.4f) const noexcept;
+    CIELCHColour CIEDarker(bool& imaginary, float amountDarker = 0.4f,
+                           CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision()) const noexcept;
 
     //==============================================================================
     /** Convert from the sRGB colour space to the XYZ colour space.
@@ -388,7 +414,36 @@ public:
     */
     static void RGBtoCIELCH(CIELCHColour c, float& L, float& C, float& H) noexcept;
 
-
+    //==============================================================================
+    /** Convert a line of pixels from the sRGB colour space to the CIE Lab colour space.
+    This gives the same result as calling RGBtoXYZ and XYZtoCIELab for each pixel, but the
+    gamma expansion is done with a lookup table and no CIELCHColour objects are created.
+    Use this when converting whole images.
+    For faster, less exact conversions see CIELCHConversion.
+    The pixels are assumed to be not premultiplied.
+
+    @param[in] pixels = the pixels to convert
+    @param[out] L = numPixels lightness values in the range 0...100
+    @param[out] a = numPixels a values
+    @param[out] b = numPixels b values
+    @param[in] numPixels = the number of pixels to convert
+    */
+    static void RGBtoCIELab(const PixelARGB* pixels, float* L, float* a, float* b, int numPixels) noexcept;
+
+    /** Convert a line of CIE Lab values to the sRGB colour space.
+    This gives the same result as calling CIELabtoXYZ and XYZtoRGB for each pixel, but no
+    CIELCHColour objects are created. Use this when converting whole images.
+    Only the red, green and blue components of the pixels are written. Their alpha is left
+    untouched and the results are not premultiplied.
+
+    @param[in] L = numPixels lightness values in the range 0...100
+    @param[in] a = numPixels a values
+    @param[in] b = numPixels b values
+    @param[out] pixels = the resulting pixels
+    @param[in] numPixels = the number of pixels to convert
+    @returns the number of imaginary colours, which had to be clipped.
+    */
+    static int CIELabtoRGB(const float* L, const float* a, const float* b, PixelARGB* pixels, int numPixels) noexcept;
 
 
 private:
@@ -399,11 +454,405 @@ private:
     static float f(float t) noexcept;
     static float fInverse(float t) noexcept;
 
-    std::unique_ptr<Colour> juceColour;
+    Colour juceColour;
 
 
 };
 
 
+//==============================================================================
+// The constructors and the conversions are defined inline, so that loops which convert one colour
+// at a time can be inlined and vectorised by the compiler.
+
+inline CIELCHColour::CIELCHColour() noexcept
+{
+}
+
+
+inline CIELCHColour::CIELCHColour(const Colour& colour) noexcept
+    : juceColour(colour)
+{
+}
+
+
+inline CIELCHColour::CIELCHColour(const CIELCHColour& other) noexcept
+    : juceColour(other.juceColour)
+{
+}
+
+inline CIELCHColour::CIELCHColour(uint32 argb) noexcept
+    : juceColour(argb)
+{
+}
+
+inline CIELCHColour::CIELCHColour(uint8 red, uint8 green, uint8 blue) noexcept
+    : juceColour(red, green, blue)
+{
+}
+
+inline CIELCHColour::CIELCHColour(uint8 red, uint8 green, uint8 blue, uint8 alpha) noexcept
+    : juceColour(red, green, blue, alpha)
+{
+}
+
+inline CIELCHColour::CIELCHColour(uint8 red, uint8 green, uint8 blue, float alpha) noexcept
+    : juceColour(red, green, blue, alpha)
+{
+}
+
+inline CIELCHColour::CIELCHColour(float hue, float saturation, float brightness, uint8 alpha) noexcept
+    : juceColour(hue, saturation, brightness, alpha)
+{
+}
+
+inline CIELCHColour::CIELCHColour(float hue, float saturation, float brightness, float alpha) noexcept
+    : juceColour(hue, saturation, brightness, alpha)
+{
+}
+
+inline CIELCHColour::CIELCHColour(PixelARGB argb) noexcept
+    : juceColour(argb)
+{
+}
+
+inline CIELCHColour::CIELCHColour(PixelRGB rgb) noexcept
+    : juceColour(rgb)
+{
+}
+
+inline CIELCHColour::CIELCHColour(PixelAlpha alpha) noexcept
+    : juceColour(alpha)
+{
+}
+
+//==============================================================================
+inline CIELCHColour& CIELCHColour::operator= (const CIELCHColour& other) noexcept
+{
+    juceColour = other.juceColour;
+    return *this;
+}
+
+inline CIELCHColour& CIELCHColour::operator= (const Colour& other) noexcept
+{
+    juceColour = other;
+    return *this;
+
+}
+
+inline Colour CIELCHColour::getJuceColour() const noexcept
+{
+    return juceColour;
+}
+
+//==============================================================================
+inline CIELCHColour CIELCHColour::fromCIELCH(float L, float C, float H, float alpha, bool& imaginary,
+                                             CIELCHPrecision precision) noexcept
+{
+    CIELCH_COUNT_CALL(fromCIELCH);
+
+    CIELCHColour colour;
+
+    if (precision == CIELCHPrecision::exact)
+    {
+        CIELCHtoRGB(L, C, H, colour, imaginary);
+    }
+    else
+    {
+        PixelARGB pixel(255, 0, 0, 0);
+
+        if (precision == CIELCHPrecision::fast)
+            imaginary = CIELCHConversion<CIELCHPrecision::fast>::CIELCHtoRGB(L, C, H, pixel);
+        else
+            imaginary = CIELCHConversion<CIELCHPrecision::fastest>::CIELCHtoRGB(L, C, H, pixel);
+
+        CIELCH_COUNT_IMAGINARY(imaginary ? 1 : 0);
+        colour = CIELCHColour(pixel.getRed(), pixel.getGreen(), pixel.getBlue());
+    }
+
+    colour = colour.getJuceColour().withAlpha(alpha);
+    return colour; 
+}
+
+inline float CIELCHColour::getCIELightness(CIELCHPrecision precision) const noexcept
+{
+    float L, C, H;
+    this->getCIELCH(L, C, H, precision);
+    return L;
+}
+
+inline float CIELCHColour::getCIEChroma(CIELCHPrecision precision) const noexcept
+{
+    float L, C, H;
+    this->getCIELCH(L, C, H, precision);
+    return C;
+}
+
+inline float CIELCHColour::getCIEHue(CIELCHPrecision precision) const noexcept
+{
+    float L, C, H;
+    this->getCIELCH(L, C, H, precision);
+    return H;
+}
+
+inline void CIELCHColour::getCIELCH(float& L, float& C, float& H, CIELCHPrecision precision) const noexcept
+{
+    CIELCH_COUNT_CALL(getCIELCH);
+
+    if (precision != CIELCHPrecision::exact)
+    {
+        const PixelARGB pixel(255, juceColour.getRed(), juceColour.getGreen(), juceColour.getBlue());
+
+        if (precision == CIELCHPrecision::fast)
+            CIELCHConversion<CIELCHPrecision::fast>::RGBtoCIELCH(pixel, L, C, H);
+        else
+            CIELCHConversion<CIELCHPrecision::fastest>::RGBtoCIELCH(pixel, L, C, H);
+
+        return;
+    }
+
+   #if CIELCH_ENABLE_COLOUR_CACHE
+    CIELCHColourCache::getCIELCH(*this, L, C, H);
+   #else
+    RGBtoCIELCH(*this, L, C, H);
+   #endif
+}
+
+
+//==============================================================================
+inline float CIELCHColour::invGammaCorrection(float g) noexcept
+{
+    if (g > 0.04045f)
+        return std::pow(((g + 0.055f) / 1.055f), 2.4f);
+    else
+        return g / 12.92f;
+}
+
+inline void CIELCHColour::RGBtoXYZ(CIELCHColour c, float& X, float&Y, float& Z) noexcept
+{
+    CIELCH_COUNT_CALL(RGBtoXYZ);
+
+    float R = c.getJuceColour().getFloatRed();
+    float G = c.getJuceColour().getFloatGreen();
+    float B = c.getJuceColour().getFloatBlue();
+
+    {
+        CIELCH_TIME_STAGE(gamma);
+        R = invGammaCorrection(R) * 100.0f;
+        G = invGammaCorrection(G) * 100.0f;
+        B = invGammaCorrection(B) * 100.0f;
+    }
+
+    //Observer = 2, Illuminant = D65
+    CIELCH_TIME_STAGE(matrix);
+    X = R * 0.4124f + G * 0.3576f + B * 0.1805f;
+    Y = R * 0.2126f + G * 0.7152f + B * 0.0722f;
+    Z = R * 0.0193f + G * 0.1192f + B * 0.9505f;
+}
+
+inline float CIELCHColour::gammaCorrection(float g) noexcept
+{
+    if (g > 0.0031308f)
+        return 1.055f * std::pow(g, (1.0f / 2.4f)) - 0.055f;
+    else
+        return 12.92f * g;
+}
+
+inline void CIELCHColour::XYZtoRGB(float X, float Y, float Z, CIELCHColour& c, bool& imaginary) noexcept
+{
+    /* (Observer = 2, Illuminant = D65)
+    X from 0 to  95.047
+    Y from 0 to 100.000
+    Z from 0 to 108.883 */
+
+    CIELCH_COUNT_CALL(XYZtoRGB);
+
+    X = X / 100.0f;
+    Y = Y / 100.0f;
+    Z = Z / 100.0f;
+
+    float R, G, B;
+
+    {
+        CIELCH_TIME_STAGE(matrix);
+        R = X *  3.2406f + Y * -1.5372f + Z * -0.4986f;
+        G = X * -0.9689f + Y *  1.8758f + Z *  0.0415f;
+        B = X *  0.0557f + Y * -0.2040f + Z *  1.0570f;
+    }
+
+    {
+        CIELCH_TIME_STAGE(gamma);
+        R = gammaCorrection(R);
+        G = gammaCorrection(G);
+        B = gammaCorrection(B);
+    }
+
+    // If R,G or B are out of bounds, we have an imaginary colour. Values less than half an
+    // 8-bit step outside are rounding errors, e.g. of colours on the surface of the sRGB cube.
+    const float tolerance = 0.5f / 255.0f;
+
+    if ((R < -tolerance || R > 1.0f + tolerance) ||
+        (G < -tolerance || G > 1.0f + tolerance) ||
+        (B < -tolerance || B > 1.0f + tolerance))
+    {
+        imaginary = true;
+        CIELCH_COUNT_IMAGINARY(1);
+    }
+    else
+    {
+        imaginary = false;
+    }
+
+    //perform clipping. 
+    if (R < 0) R = 0;
+    else if (R > 1) R = 1;
+    if (G < 0) G = 0;
+    else if (G > 1) G = 1;
+    if (B < 0) B = 0;
+    else if (B > 1) B = 1;
+
+    c = CIELCHColour((uint8)std::round(R * 255.0f), (uint8)std::round(G * 255.0f), (uint8)std::round(B * 255.0f));
+}
+
+inline float CIELCHColour::f(float t) noexcept
+{
+    if (t > 0.008856f)
+        return std::pow(t, (1.0f / 3.0f));
+    else
+        return (7.787f * t) + (16.0f / 116.0f);
+}
+
+inline void CIELCHColour::XYZtoCIELab(float X, float Y, float Z, float& L, float& a, float& b) noexcept
+{
+    /* Observer = 2, Illuminant = D65
+    ref_X =  95.047
+    ref_Y = 100.000
+    ref_Z = 108.883 */
+    CIELCH_COUNT_CALL(XYZtoCIELab);
+    CIELCH_TIME_STAGE(companding);
+
+    X = X / 95.047f;
+    Y = Y / 100.000f;
+    Z = Z / 108.883f;
+
+    X = f(X);
+    Y = f(Y);
+    Z = f(Z);
+
+    L = (116.0f * Y) - 16.0f;
+    a = 500.0f * (X - Y);
+    b = 200.0f * (Y - Z);
+
+}
+
+inline float CIELCHColour::fInverse(float t) noexcept
+{
+    if (t > 6.0f / 29.0f)
+        return std::pow(t, 3.0f);
+    else
+        return (t - 16.0f / 116.0f) / 7.787f;
+}
+
+inline void CIELCHColour::CIELabtoXYZ(float L, float a, float b, float& X, float& Y, float& Z) noexcept
+{
+    CIELCH_COUNT_CALL(CIELabtoXYZ);
+    CIELCH_TIME_STAGE(companding);
+
+    Y = (L + 16.0f) / 116.0f;
+    X = a / 500.0f + Y;
+    Z = Y - b / 200.0f;
+
+    X = fInverse(X);
+    Y = fInverse(Y);
+    Z = fInverse(Z);
+
+    /* Observer= 2, Illuminant= D65
+    ref_X =  95.047
+    ref_Y = 100.000
+    ref_Z = 108.883 */
+    X = 95.047f * X;
+    Y = 100.000f * Y;
+    Z = 108.883f * Z;
+}
+
+inline void CIELCHColour::CIELabtoCIELCH(float L, float a, float b, float& Lout, float& C, float& H) noexcept
+{
+    CIELCH_COUNT_CALL(CIELabtoCIELCH);
+    CIELCH_TIME_STAGE(polar);
+
+    H = std::atan2(b, a);
+
+    if (H > 0)
+        H = (H / float_Pi) * 180.0f;
+    else
+        H = 360.0f - (std::abs(H) / float_Pi) * 180.0f;
+
+    Lout = L;
+    C = std::sqrt(a*a + b*b);
+
+}
+
+inline void CIELCHColour::CIELCHtoCIELab(float L, float C, float H, float& Lout, float& a, float& b) noexcept
+{
+    CIELCH_COUNT_CALL(CIELCHtoCIELab);
+    CIELCH_TIME_STAGE(polar);
+
+    Lout = L;
+    a = std::cos(H * float_Pi / 180.0f) * C;
+    b = std::sin(H * float_Pi / 180.0f) * C;
+}
+
+inline void CIELCHColour::CIELCHtoRGB(float L, float C, float H, CIELCHColour& c, bool& imaginary) noexcept
+{
+    CIELCH_COUNT_CALL(CIELCHtoRGB);
+
+    //Lightness from 0 to 100
+    L = L * 100.0f;
+    if (L > 100.0f) L = 100.0f;
+    if (L < 0.0f) L = 0.0f;
+    //Chroma from 0 to 134.0
+    C = C * 134.0f;
+    if (C > 134.0f) C = 134.0f;
+    if (C < 0.0f) C = 0.0f;
+    //Hue in degrees. 
+    H = H * 360.0f;
+
+    float L_ab, a, b;
+    CIELCHtoCIELab(L, C, H, L_ab, a, b);
+    float X, Y, Z;
+    CIELabtoXYZ(L_ab, a, b, X, Y, Z);
+    XYZtoRGB(X, Y, Z, c, imaginary);
+}
+
+inline void CIELCHColour::RGBtoCIELCH(CIELCHColour c, float& L, float& C, float& H) noexcept
+{
+    CIELCH_COUNT_CALL(RGBtoCIELCH);
+
+    float X, Y, Z;
+    RGBtoXYZ(c, X, Y, Z);
+    float L_ab, a, b;
+    XYZtoCIELab(X, Y, Z, L_ab, a, b);
+    CIELabtoCIELCH(L_ab, a, b, L, C, H);
+    //rescale values 
+    L = L / 100.0f;
+    C = C / 134.0f;
+    H = H / 360.0f;
+}
+
+//==============================================================================
+inline void CIELCHColour::RGBtoCIELab(const PixelARGB* pixels, float* L, float* a, float* b, int numPixels) noexcept
+{
+    CIELCH_COUNT_CALL(RGBtoCIELabLine);
+    CIELCHConversion<CIELCHPrecision::exact>::RGBtoCIELab(pixels, L, a, b, numPixels);
+}
+
+inline int CIELCHColour::CIELabtoRGB(const float* L, const float* a, const float* b, PixelARGB* pixels, int numPixels) noexcept
+{
+    CIELCH_COUNT_CALL(CIELabtoRGBLine);
+
+    const int numImaginary = CIELCHConversion<CIELCHPrecision::exact>::CIELabtoRGB(L, a, b, pixels, numPixels);
+    CIELCH_COUNT_IMAGINARY(numImaginary);
+    return numImaginary;
+}
+
 
 #endif  // CIELCHColour_H_INCLUDED
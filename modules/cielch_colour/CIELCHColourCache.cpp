@@ -0,0 +1,129 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+namespace
+{
+    /** The key of an entry is the RGB value with all alpha bits set, so that 0 marks an empty one */
+    struct CacheEntry
+    {
+        uint32 key;
+        float L, C, H;
+    };
+
+    /** One thread's cache. It is trivially constructible, so that the thread-local storage is
+    zero-initialised without a constructor call or a registered destructor.
+    */
+    struct ThreadCache
+    {
+        CacheEntry entries[CIELCHColourCache::numWays][CIELCHColourCache::numEntriesPerWay];
+
+        /** The state of the random number generator which picks the way to replace on a miss.
+        Random replacement avoids the pathological misses of LRU on a cycle through more colours
+        than fit into a set.
+        */
+        uint32 randomState;
+
+        uint64 hits, misses;
+    };
+
+    thread_local ThreadCache threadCache;
+
+    static_assert(CIELCHColourCache::numWays == 2 && CIELCHColourCache::numEntriesPerWay == 256,
+                  "getIndex() returns 8 bits, and the replacement picks one of 2 ways");
+
+    /** A different multiplicative hash for each way, so that two colours which share an entry in
+    one way are unlikely to share one in the other
+    */
+    inline int getIndex(uint32 key, int way) noexcept
+    {
+        if (way == 0)
+            return (int) ((key * 0x9e3779b1u) >> 24);
+
+        return (int) (((key ^ (key >> 15)) * 0x85ebca6bu) >> 24);
+    }
+}
+
+//==============================================================================
+double CIELCHColourCache::Statistics::getHitRate() const noexcept
+{
+    const uint64 lookups = hits + misses;
+    return lookups > 0 ? (double) hits / (double) lookups : 0.0;
+}
+
+void CIELCHColourCache::getCIELCH(const CIELCHColour& colour, float& L, float& C, float& H) noexcept
+{
+    ThreadCache& cache = threadCache;
+    const uint32 key = colour.getJuceColour().getARGB() | 0xff000000u;
+
+    CacheEntry& first = cache.entries[0][getIndex(key, 0)];
+    CacheEntry& second = cache.entries[1][getIndex(key, 1)];
+    const CacheEntry* hit = first.key == key ? &first
+                          : (second.key == key ? &second : nullptr);
+
+    if (hit != nullptr)
+    {
+        L = hit->L;
+        C = hit->C;
+        H = hit->H;
+        ++cache.hits;
+        return;
+    }
+
+    CIELCHColour::RGBtoCIELCH(colour, L, C, H);
+
+    // an empty entry if there is one, otherwise a random one (xorshift32)
+    uint32 r = cache.randomState != 0 ? cache.randomState : 0x2545f491u;
+    r ^= r << 13;
+    r ^= r >> 17;
+    r ^= r << 5;
+    cache.randomState = r;
+
+    CacheEntry& replaced = first.key == 0 ? first
+                         : (second.key == 0 ? second : ((r & 1) != 0 ? second : first));
+    replaced = { key, L, C, H };
+    ++cache.misses;
+}
+
+CIELCHColourCache::Statistics CIELCHColourCache::getThreadStatistics() noexcept
+{
+    Statistics s;
+    s.hits = threadCache.hits;
+    s.misses = threadCache.misses;
+    return s;
+}
+
+void CIELCHColourCache::clear() noexcept
+{
+    std::memset(&threadCache, 0, sizeof(ThreadCache));
+}
@@ -0,0 +1,102 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+#ifndef CIELCHColourCache_H_INCLUDED
+#define CIELCHColourCache_H_INCLUDED
+
+class CIELCHColour;
+
+//==============================================================================
+/**
+A small cache of CIE LCH values in front of CIELCHColour::RGBtoCIELCH.
+
+User interfaces convert the same few hundred colours again and again: theme colours, swatches,
+the colours passed to CIELighter and CIEDarker. The cache remembers the CIE LCH values of up to
+512 colours per thread, so a repeated colour costs two hashes and two compares instead of the pow,
+cbrt, atan2 and sqrt of the conversion.
+
+Every thread has its own cache: a fixed-size table of 8 KB in thread-local storage, so a lookup
+takes no lock, does not allocate, and can be used on any thread, including audio threads. The
+table is 2-way skewed associative: each way is indexed with a different hash, so colours which
+collide in one way rarely collide in the other, and a cycle through a few hundred colours hardly
+ever misses. The cached values are the results of RGBtoCIELCH, so they are exactly the same as the
+uncached ones. The alpha of the colour is ignored, because it does not change the CIE LCH values.
+
+CIELCHColour::getCIELCH, and with it getCIELightness, the with...() functions, CIELighter and
+CIEDarker, use the cache if CIELCH_ENABLE_COLOUR_CACHE is enabled. Other code can call
+getCIELCH() directly.
+
+Here an example on how to use the class:
+@code
+float L, C, H;
+CIELCHColourCache::getCIELCH(findColour(TextButton::buttonColourId), L, C, H);
+
+const CIELCHColourCache::Statistics stats = CIELCHColourCache::getThreadStatistics();
+DBG(String(stats.getHitRate() * 100.0, 1) << "% hits");
+@endcode
+*/
+class CIELCHColourCache
+{
+public:
+
+    /** The number of colours each thread's cache can hold */
+    enum { numWays = 2, numEntriesPerWay = 256, numEntries = numWays * numEntriesPerWay };
+
+    /** The counters of one thread's cache */
+    struct Statistics
+    {
+        uint64 hits = 0;
+        uint64 misses = 0;
+
+        /** Returns hits / (hits + misses), or 0 if nothing was looked up. */
+        double getHitRate() const noexcept;
+    };
+
+    /** Returns the CIE LCH values of a colour, in the range 0...1 like CIELCHColour::RGBtoCIELCH,
+    from the calling thread's cache, or converts and caches them.
+    */
+    static void getCIELCH(const CIELCHColour& colour, float& L, float& C, float& H) noexcept;
+
+    /** Returns the hits and misses of the calling thread's cache since its last clear(). */
+    static Statistics getThreadStatistics() noexcept;
+
+    /** Empties the calling thread's cache and sets its counters to zero. */
+    static void clear() noexcept;
+
+private:
+
+    CIELCHColourCache() = delete;
+};
+
+
+#endif  // CIELCHColourCache_H_INCLUDED
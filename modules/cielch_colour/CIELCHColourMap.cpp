@@ -0,0 +1,174 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+namespace
+{
+    template <class PixelType>
+    void mapLine(const CIELCHColourMap& map, const float* values, uint8* dest, int pixelStride,
+                 int numValues, float minValue, float maxValue) noexcept
+    {
+        const float range = maxValue - minValue;
+        const float valueScale = range != 0.0f ? 1.0f / range : 0.0f;
+
+        for (int i = 0; i < numValues; ++i)
+        {
+            reinterpret_cast<PixelType*>(dest)->set(map.lookup((values[i] - minValue) * valueScale));
+            dest += pixelStride;
+        }
+    }
+}
+
+//==============================================================================
+CIELCHColourMap::CIELCHColourMap(const Array<Stop>& unsortedStops, int numEntries, bool reduceChroma)
+{
+    // a colour map needs at least one stop
+    jassert(unsortedStops.size() > 0);
+
+    std::vector<Stop> stops(unsortedStops.begin(), unsortedStops.end());
+
+    if (stops.empty())
+        stops.push_back({ 0.0f, 0.0f, 0.0f, 0.0f });
+
+    std::stable_sort(stops.begin(), stops.end(), [] (const Stop& first, const Stop& second)
+    {
+        return first.position < second.position;
+    });
+
+    numEntries = jmax(2, numEntries);
+    scale = (float) (numEntries - 1);
+
+    HeapBlock<float> L((size_t) numEntries), C((size_t) numEntries), H((size_t) numEntries);
+    size_t segment = 0;
+
+    for (int i = 0; i < numEntries; ++i)
+    {
+        const float position = (float) i / scale;
+
+        while (segment + 1 < stops.size() && stops[segment + 1].position <= position)
+            ++segment;
+
+        const Stop& from = stops[segment];
+
+        if (segment + 1 == stops.size() || position <= from.position)
+        {
+            L[i] = from.L;
+            C[i] = from.C;
+            H[i] = from.H;
+        }
+        else
+        {
+            const Stop& to = stops[segment + 1];
+            const float t = (position - from.position) / (to.position - from.position);
+
+            // the hue goes the shorter way around the colour circle
+            float hueDifference = to.H - from.H;
+            hueDifference -= std::round(hueDifference);
+
+            L[i] = from.L + t * (to.L - from.L);
+            C[i] = from.C + t * (to.C - from.C);
+            H[i] = from.H + t * hueDifference;
+            H[i] -= std::floor(H[i]);
+        }
+
+        L[i] = jlimit(0.0f, 1.0f, L[i]);
+        C[i] = jmax(0.0f, C[i]);
+
+        if (reduceChroma)
+            C[i] = jmin(C[i], CIELCHConversionTables::getMaxChroma(L[i], H[i]));
+    }
+
+    table.insertMultiple(0, PixelARGB(255, 0, 0, 0), numEntries);
+    CIELCHConversion<CIELCHPrecision::exact>::CIELCHtoRGB(L, C, H, table.getRawDataPointer(), numEntries);
+}
+
+CIELCHColourMap CIELCHColourMap::lightnessRamp(float startL, float endL, float chroma, float hue,
+                                               int numEntries)
+{
+    Array<Stop> stops;
+    stops.add({ 0.0f, startL, chroma, hue });
+    stops.add({ 1.0f, endL, chroma, hue });
+
+    return CIELCHColourMap(stops, numEntries);
+}
+
+CIELCHColourMap CIELCHColourMap::constantChromaRamp(float startL, float endL, float chroma,
+                                                    float startHue, float hueRotation,
+                                                    int numEntries)
+{
+    // stops are interpolated along the shorter way around the colour circle,
+    // so the rotation is split into segments of less than half a turn each
+    const int numSegments = 1 + (int) (std::abs(hueRotation) * 4.0f);
+    Array<Stop> stops;
+
+    for (int i = 0; i <= numSegments; ++i)
+    {
+        const float t = (float) i / (float) numSegments;
+        stops.add({ t, startL + t * (endL - startL), chroma, startHue + t * hueRotation });
+    }
+
+    return CIELCHColourMap(stops, numEntries);
+}
+
+//==============================================================================
+void CIELCHColourMap::mapValues(const float* values, PixelARGB* dest, int numValues,
+                                float minValue, float maxValue) const noexcept
+{
+    mapLine<PixelARGB>(*this, values, reinterpret_cast<uint8*>(dest), (int) sizeof(PixelARGB),
+                       numValues, minValue, maxValue);
+}
+
+void CIELCHColourMap::mapValues(const float* values, const Image::BitmapData& data, int y,
+                                float minValue, float maxValue) const noexcept
+{
+    jassert(isPositiveAndBelow(y, data.height));
+
+    uint8* dest = data.getLinePointer(y);
+
+    // the table is opaque, so the pixels are the same premultiplied and non premultiplied
+    switch (data.pixelFormat)
+    {
+        case Image::ARGB:
+            mapLine<PixelARGB>(*this, values, dest, data.pixelStride, data.width, minValue, maxValue);
+            break;
+        case Image::RGB:
+            mapLine<PixelRGB>(*this, values, dest, data.pixelStride, data.width, minValue, maxValue);
+            break;
+        case Image::SingleChannel:
+            mapLine<PixelAlpha>(*this, values, dest, data.pixelStride, data.width, minValue, maxValue);
+            break;
+        default:
+            jassertfalse;
+            break;
+    }
+}
@@ -0,0 +1,140 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+#ifndef CIELCHColourMap_H_INCLUDED
+#define CIELCHColourMap_H_INCLUDED
+
+//==============================================================================
+/**
+A colour map (e.g. for spectrograms and level meters), which follows a path through CIE LCH space.
+
+Because CIE LCH is perceptually uniform, equal steps of the mapped value give equal visual steps
+of colour, which is not true for maps built with HSV or RGB gradients.
+
+The path is defined by stops, between which lightness and chroma are interpolated linearly and
+the hue along the shorter way around the colour circle. When the map is created, the path is
+sampled into a table of opaque PixelARGB values. Looking up a value afterwards costs only a
+multiplication and a table access, with no colour conversion at all. So the table size is a
+trade-off between the smoothness of the map and the memory it uses: 256 entries are enough for
+8 bit displays, 1024 or 4096 entries avoid visible banding on long, smooth gradients.
+
+Parts of the path can lie outside the sRGB gamut. By default the chroma of every table entry is
+then reduced to the highest chroma sRGB can display for its lightness and hue, which keeps
+lightness and hue exact. The limit comes from CIELCHConversionTables::getMaxChroma, so close to
+the cusps of the gamut a few entries can still be slightly outside, and are clipped.
+Otherwise the colour is clipped like CIELCHColour::fromCIELCH does.
+
+Here an example on how to use the class:
+@code
+const CIELCHColourMap map = CIELCHColourMap::constantChromaRamp(0.1f, 0.95f, 0.4f, 0.7f, -0.6f);
+
+// per frame, for every line of the spectrogram image
+map.mapValues(magnitudes, bitmapData, y, -100.0f, 0.0f);
+@endcode
+*/
+class CIELCHColourMap
+{
+public:
+
+    /** A point of the path. All values are in the range 0...1. */
+    struct Stop
+    {
+        float position;     /**< the mapped value at which the path passes this stop */
+        float L, C, H;      /**< the CIE lightness, chroma and hue, like in CIELCHColour */
+    };
+
+    /** Creates a map following a multi-stop path.
+    @param stops = the stops of the path. They don't need to be sorted. Values below the first
+                   or above the last stop get the colour of that stop.
+    @param numEntries = the size of the table, e.g. 256, 1024 or 4096
+    @param reduceChromaToGamut = if true, colours outside the sRGB gamut keep their lightness and
+                                 hue and get the highest displayable chroma. If false, they are
+                                 clipped like in CIELCHColour::fromCIELCH.
+    */
+    CIELCHColourMap(const Array<Stop>& stops, int numEntries = 1024, bool reduceChromaToGamut = true);
+
+    /** Creates a map from startL to endL with a constant chroma and hue. */
+    static CIELCHColourMap lightnessRamp(float startL, float endL, float chroma, float hue,
+                                         int numEntries = 1024);
+
+    /** Creates a map from startL to endL with a constant chroma, along which the hue rotates
+    by hueRotation (in the range -1...1, so 1 is a full turn around the colour circle).
+    Chroma which sRGB cannot display at some lightness is reduced there.
+    */
+    static CIELCHColourMap constantChromaRamp(float startL, float endL, float chroma,
+                                              float startHue, float hueRotation,
+                                              int numEntries = 1024);
+
+    //==============================================================================
+    /** Returns the colour for a value in the range 0...1. Values outside are clamped. */
+    PixelARGB lookup(float value) const noexcept
+    {
+        const float scaled = value * scale;
+
+        // written so that NaN fails both comparisons and ends up at index 0
+        const float clamped = scaled > 0.0f ? (scaled < scale ? scaled : scale) : 0.0f;
+        return table.getUnchecked((int) (clamped + 0.5f));
+    }
+
+    /** Returns the colour for a value in the range 0...1 as a JUCE Colour. */
+    Colour getColour(float value) const noexcept    { return Colour(lookup(value)); }
+
+    /** Maps numValues values in the range minValue...maxValue to colours. */
+    void mapValues(const float* values, PixelARGB* dest, int numValues,
+                   float minValue = 0.0f, float maxValue = 1.0f) const noexcept;
+
+    /** Maps data.width values in the range minValue...maxValue to line y of a bitmap.
+    All pixel formats are supported. Because the colours are opaque, SingleChannel images are
+    simply filled with 255.
+    */
+    void mapValues(const float* values, const Image::BitmapData& data, int y,
+                   float minValue = 0.0f, float maxValue = 1.0f) const noexcept;
+
+    //==============================================================================
+    /** Returns the size of the table. */
+    int getNumEntries() const noexcept                  { return table.size(); }
+
+    /** Returns the table. Entry i is the colour of the value i / (getNumEntries() - 1). */
+    const Array<PixelARGB>& getTable() const noexcept   { return table; }
+
+private:
+
+    Array<PixelARGB> table;
+    float scale;
+
+    JUCE_LEAK_DETECTOR(CIELCHColourMap)
+};
+
+
+#endif  // CIELCHColourMap_H_INCLUDED
@@ -0,0 +1,516 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+namespace
+{
+    /** The alpha of the imaginary colours on the plane */
+    const uint8 pickerImaginaryAlpha = 72;
+
+    /** The number of hue samples of the gamut boundary on the wheel */
+    const int pickerNumHueSamples = 720;
+
+    const float pickerCursorRadius = 6.0f;
+
+    typedef CIELCHConversion<CIELCHPrecision::exact> PickerConversion;
+
+    /** Converts a line of CIE LCH values to pixels for CIELCHImageLine::write, fading the ones with
+    a chroma above maxChroma and hiding the ones with a negative maxChroma.
+    */
+    void convertPickerLine(const float* L, const float* C, const float* H, const float* maxChroma,
+                           PixelARGB* pixels, int numPixels, const CIELCHConverter& converter) noexcept
+    {
+        for (int i = 0; i < numPixels; ++i)
+            pixels[i].setARGB(255, 0, 0, 0);
+
+        converter.CIELCHtoRGB(L, C, H, pixels, numPixels);
+
+        for (int i = 0; i < numPixels; ++i)
+        {
+            if (maxChroma[i] < 0.0f)
+                pixels[i].setARGB(0, 0, 0, 0);
+            else if (C[i] > maxChroma[i])
+                pixels[i].setAlpha(pickerImaginaryAlpha);
+        }
+    }
+
+    void strokeGamutBoundary(Image& image, const Path& boundary)
+    {
+        Graphics g(image);
+        g.setColour(Colours::black.withAlpha(0.5f));
+        g.strokePath(boundary, PathStrokeType(3.0f));
+        g.setColour(Colours::white);
+        g.strokePath(boundary, PathStrokeType(1.5f));
+    }
+}
+
+//==============================================================================
+/** Renders the plane and its gamut boundary on the render thread, and hands the image over to the
+message thread unless a newer render has been started in the meantime.
+*/
+class CIELCHColourPicker::PlaneRenderer  : public ThreadPoolJob
+{
+public:
+
+    PlaneRenderer(CIELCHColourPicker& picker, int planeWidth, int planeHeight)
+        : ThreadPoolJob("CIELCHColourPicker"),
+          safePicker(&picker),
+          generation(picker.renderGeneration),
+          myGeneration(++picker.renderGeneration),
+          layout(picker.layout),
+          width(planeWidth),
+          height(planeHeight),
+          fixedValue(picker.getFixedValue())
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        Image image(Image::ARGB, width, height, true, SoftwareImageType());
+
+        const bool finished = layout == Layout::lightnessChromaPlane ? renderLightnessChromaPlane(image)
+                                                                     : renderChromaHueWheel(image);
+        if (!finished)
+            return jobHasFinished;
+
+        auto picker = safePicker;
+        const int renderGeneration = myGeneration;
+
+        MessageManager::callAsync([picker, image, renderGeneration]
+        {
+            if (auto* p = picker.getComponent())
+            {
+                if (p->renderGeneration == renderGeneration)
+                {
+                    p->deliveredGeneration = renderGeneration;
+                    p->planeImage = image;
+                    p->repaint(p->planeArea);
+                }
+            }
+        });
+
+        return jobHasFinished;
+    }
+
+private:
+
+    bool isOvertaken() const
+    {
+        return generation != myGeneration || shouldExit();
+    }
+
+    /** Lightness upwards and chroma to the right, at the hue of the strip */
+    bool renderLightnessChromaPlane(Image& image)
+    {
+        const CIELCHConverter converter(CIELCHPrecision::fast);
+        const Image::BitmapData data(image, Image::BitmapData::writeOnly);
+
+        HeapBlock<float> L((size_t) width), C((size_t) width), H((size_t) width), maxChroma((size_t) width);
+        HeapBlock<PixelARGB> pixels((size_t) width);
+        Path boundary;
+
+        for (int x = 0; x < width; ++x)
+        {
+            C[x] = (float) x / (float) jmax(1, width - 1);
+            H[x] = fixedValue;
+        }
+
+        for (int y = 0; y < height; ++y)
+        {
+            if (isOvertaken())
+                return false;
+
+            const float lightness = 1.0f - (float) y / (float) jmax(1, height - 1);
+            const float rowMaxChroma = CIELCHConversionTables::getMaxChroma(lightness, fixedValue);
+
+            for (int x = 0; x < width; ++x)
+            {
+                L[x] = lightness;
+                maxChroma[x] = rowMaxChroma;
+            }
+
+            convertPickerLine(L, C, H, maxChroma, pixels, width, converter);
+            CIELCHImageLine::write(data, y, pixels);
+
+            const Point<float> point(rowMaxChroma * (float) (width - 1), (float) y);
+
+            if (y == 0)
+                boundary.startNewSubPath(point);
+            else
+                boundary.lineTo(point);
+        }
+
+        strokeGamutBoundary(image, boundary);
+        return true;
+    }
+
+    /** Hue around and chroma outwards, at the lightness of the strip */
+    bool renderChromaHueWheel(Image& image)
+    {
+        const CIELCHConverter converter(CIELCHPrecision::fast);
+
+        HeapBlock<float> hueMaxChroma(pickerNumHueSamples + 1);
+
+        for (int i = 0; i < pickerNumHueSamples; ++i)
+        {
+            if (isOvertaken())
+                return false;
+
+            hueMaxChroma[i] = CIELCHConversionTables::getMaxChroma(fixedValue, (float) i / (float) pickerNumHueSamples);
+        }
+
+        hueMaxChroma[pickerNumHueSamples] = hueMaxChroma[0];
+
+        const Point<float> centre((float) (width - 1) * 0.5f, (float) (height - 1) * 0.5f);
+        const float radius = jmax(1.0f, (float) jmin(width, height) * 0.5f - 1.0f);
+
+        {
+            const Image::BitmapData data(image, Image::BitmapData::writeOnly);
+
+            HeapBlock<float> L((size_t) width), C((size_t) width), H((size_t) width), maxChroma((size_t) width);
+            HeapBlock<PixelARGB> pixels((size_t) width);
+
+            for (int y = 0; y < height; ++y)
+            {
+                if (isOvertaken())
+                    return false;
+
+                for (int x = 0; x < width; ++x)
+                {
+                    const float dx = (float) x - centre.x;
+                    const float dy = centre.y - (float) y;
+                    const float angle = std::atan2(dy, dx) / (2.0f * float_Pi);
+
+                    L[x] = fixedValue;
+                    C[x] = std::sqrt(dx * dx + dy * dy) / radius;
+                    H[x] = angle < 0.0f ? angle + 1.0f : angle;
+
+                    const float sample = H[x] * pickerNumHueSamples;
+                    const int index = jlimit(0, pickerNumHueSamples - 1, (int) sample);
+                    const float fraction = sample - (float) index;
+                    maxChroma[x] = C[x] > 1.0f ? -1.0f
+                                               : hueMaxChroma[index] + fraction * (hueMaxChroma[index + 1] - hueMaxChroma[index]);
+                }
+
+                convertPickerLine(L, C, H, maxChroma, pixels, width, converter);
+                CIELCHImageLine::write(data, y, pixels);
+            }
+        }
+
+        Path boundary;
+
+        for (int i = 0; i < pickerNumHueSamples; ++i)
+        {
+            const float angle = (float) i * 2.0f * float_Pi / (float) pickerNumHueSamples;
+            const Point<float> point(centre.x + hueMaxChroma[i] * radius * std::cos(angle),
+                                     centre.y - hueMaxChroma[i] * radius * std::sin(angle));
+            if (i == 0)
+                boundary.startNewSubPath(point);
+            else
+                boundary.lineTo(point);
+        }
+
+        boundary.closeSubPath();
+        strokeGamutBoundary(image, boundary);
+        return true;
+    }
+
+    const Component::SafePointer<CIELCHColourPicker> safePicker;
+    const std::atomic<int>& generation;
+    const int myGeneration;
+    const Layout layout;
+    const int width, height;
+    const float fixedValue;
+
+    JUCE_DECLARE_NON_COPYABLE(PlaneRenderer)
+};
+
+//==============================================================================
+CIELCHColourPicker::CIELCHColourPicker(Layout initialLayout)
+    : layout(initialLayout)
+{
+    setOpaque(false);
+}
+
+CIELCHColourPicker::~CIELCHColourPicker()
+{
+    // makes a running render stop at its next line
+    ++renderGeneration;
+    renderPool.removeAllJobs(true, -1);
+}
+
+void CIELCHColourPicker::setLayout(Layout newLayout)
+{
+    if (layout != newLayout)
+    {
+        layout = newLayout;
+        planeImage = Image();
+        resized();
+        repaint();
+    }
+}
+
+//==============================================================================
+CIELCHColour CIELCHColourPicker::getCurrentColour() const
+{
+    bool imaginary;
+    return CIELCHColour::fromCIELCH(lightness, chroma, hue, 1.0f, imaginary);
+}
+
+void CIELCHColourPicker::setCurrentColour(const CIELCHColour& colour, NotificationType notification)
+{
+    float L, C, H;
+    colour.getCIELCH(L, C, H);
+
+    // keep the hue of greys, so that the plane doesn't jump
+    setCurrentCIELCH(L, C, C > 0.0f ? H : hue, notification);
+}
+
+void CIELCHColourPicker::getCurrentCIELCH(float& L, float& C, float& H) const noexcept
+{
+    L = lightness;
+    C = chroma;
+    H = hue;
+}
+
+void CIELCHColourPicker::setCurrentCIELCH(float L, float C, float H, NotificationType notification)
+{
+    L = jlimit(0.0f, 1.0f, L);
+    C = jlimit(0.0f, 1.0f, C);
+    H = H - std::floor(H);
+
+    if (L == lightness && C == chroma && H == hue)
+        return;
+
+    const float oldFixedValue = getFixedValue();
+
+    // only the old and the new cursor are repainted, on top of the cached plane
+    repaint(getCursorBounds());
+    repaint(stripArea);
+
+    lightness = L;
+    chroma = C;
+    hue = H;
+
+    repaint(getCursorBounds());
+
+    if (getFixedValue() != oldFixedValue)
+        startPlaneRender();
+
+    if (notification != dontSendNotification)
+        sendChangeMessage();
+}
+
+bool CIELCHColourPicker::isCurrentColourImaginary() const
+{
+    PixelARGB pixel;
+    return PickerConversion::CIELCHtoRGB(lightness, chroma, hue, pixel);
+}
+
+bool CIELCHColourPicker::isPlaneUpToDate() const noexcept
+{
+    return deliveredGeneration == renderGeneration;
+}
+
+//==============================================================================
+void CIELCHColourPicker::paint(Graphics& g)
+{
+    if (planeImage.isValid())
+        g.drawImageAt(planeImage, planeArea.getX(), planeArea.getY());
+
+    if (stripImage.isValid())
+        g.drawImageAt(stripImage, stripArea.getX(), stripArea.getY());
+
+    const float stripValue = layout == Layout::lightnessChromaPlane ? hue : 1.0f - lightness;
+    const float stripY = (float) stripArea.getY() + stripValue * (float) (stripArea.getHeight() - 1);
+
+    g.setColour(Colours::black);
+    g.fillRect((float) stripArea.getX(), stripY - 1.5f, (float) stripArea.getWidth(), 3.0f);
+    g.setColour(Colours::white);
+    g.fillRect((float) stripArea.getX(), stripY - 0.5f, (float) stripArea.getWidth(), 1.0f);
+
+    const Point<float> cursor = getCursorPosition();
+    const Rectangle<float> cursorArea(cursor.x - pickerCursorRadius, cursor.y - pickerCursorRadius,
+                                      2.0f * pickerCursorRadius, 2.0f * pickerCursorRadius);
+
+    g.setColour(getCurrentColour().getJuceColour());
+    g.fillEllipse(cursorArea);
+    g.setColour(Colours::black);
+    g.drawEllipse(cursorArea, 2.5f);
+    g.setColour(Colours::white);
+    g.drawEllipse(cursorArea, 1.0f);
+}
+
+void CIELCHColourPicker::resized()
+{
+    Rectangle<int> bounds = getLocalBounds().reduced((int) pickerCursorRadius + 2);
+
+    stripArea = bounds.removeFromRight(jlimit(8, 24, bounds.getWidth() / 8));
+    bounds.removeFromRight(jmax(4, stripArea.getWidth() / 2));
+
+    if (layout == Layout::chromaHueWheel)
+    {
+        const int size = jmin(bounds.getWidth(), bounds.getHeight());
+        bounds = bounds.withSizeKeepingCentre(size, size);
+    }
+
+    planeArea = bounds;
+
+    renderStrip();
+    startPlaneRender();
+}
+
+void CIELCHColourPicker::mouseDown(const MouseEvent& e)
+{
+    draggingStrip = stripArea.expanded(4, (int) pickerCursorRadius).contains(e.getPosition());
+    mouseDrag(e);
+}
+
+void CIELCHColourPicker::mouseDrag(const MouseEvent& e)
+{
+    if (draggingStrip)
+        setFromStrip((float) e.y, sendNotification);
+    else
+        setFromPlane(e.position, sendNotification);
+}
+
+//==============================================================================
+float CIELCHColourPicker::getFixedValue() const noexcept
+{
+    return layout == Layout::lightnessChromaPlane ? hue : lightness;
+}
+
+Point<float> CIELCHColourPicker::getCursorPosition() const noexcept
+{
+    if (layout == Layout::lightnessChromaPlane)
+        return { (float) planeArea.getX() + chroma * (float) (planeArea.getWidth() - 1),
+                 (float) planeArea.getY() + (1.0f - lightness) * (float) (planeArea.getHeight() - 1) };
+
+    const float radius = jmax(1.0f, (float) planeArea.getWidth() * 0.5f - 1.0f);
+    const float angle = hue * 2.0f * float_Pi;
+    const Point<float> centre = planeArea.toFloat().getCentre();
+
+    return { centre.x + chroma * radius * std::cos(angle), centre.y - chroma * radius * std::sin(angle) };
+}
+
+Rectangle<int> CIELCHColourPicker::getCursorBounds() const noexcept
+{
+    const Point<float> cursor = getCursorPosition();
+    const int size = (int) (2.0f * pickerCursorRadius) + 6;
+
+    return Rectangle<int>(size, size).withCentre(cursor.toInt());
+}
+
+void CIELCHColourPicker::setFromPlane(Point<float> position, NotificationType notification)
+{
+    if (planeArea.isEmpty())
+        return;
+
+    if (layout == Layout::lightnessChromaPlane)
+    {
+        const float C = (position.x - (float) planeArea.getX()) / (float) jmax(1, planeArea.getWidth() - 1);
+        const float L = 1.0f - (position.y - (float) planeArea.getY()) / (float) jmax(1, planeArea.getHeight() - 1);
+        setCurrentCIELCH(L, C, hue, notification);
+    }
+    else
+    {
+        const Point<float> centre = planeArea.toFloat().getCentre();
+        const float radius = jmax(1.0f, (float) planeArea.getWidth() * 0.5f - 1.0f);
+        const float dx = position.x - centre.x;
+        const float dy = centre.y - position.y;
+
+        setCurrentCIELCH(lightness, std::sqrt(dx * dx + dy * dy) / radius,
+                         std::atan2(dy, dx) / (2.0f * float_Pi), notification);
+    }
+}
+
+void CIELCHColourPicker::setFromStrip(float y, NotificationType notification)
+{
+    const float value = jlimit(0.0f, 1.0f, (y - (float) stripArea.getY()) / (float) jmax(1, stripArea.getHeight() - 1));
+
+    if (layout == Layout::lightnessChromaPlane)
+        setCurrentCIELCH(lightness, chroma, jmin(value, 0.9999f), notification);
+    else
+        setCurrentCIELCH(1.0f - value, chroma, hue, notification);
+}
+
+void CIELCHColourPicker::renderStrip()
+{
+    if (stripArea.isEmpty())
+    {
+        stripImage = Image();
+        return;
+    }
+
+    // the strip doesn't depend on the colour, so it is only rendered when its size changes
+    stripImage = Image(Image::ARGB, stripArea.getWidth(), stripArea.getHeight(), false);
+
+    const Image::BitmapData data(stripImage, Image::BitmapData::writeOnly);
+    HeapBlock<PixelARGB> pixels((size_t) data.width);
+
+    for (int y = 0; y < data.height; ++y)
+    {
+        const float value = (float) y / (float) jmax(1, data.height - 1);
+        PixelARGB pixel;
+        pixel.setARGB(255, 0, 0, 0);
+
+        if (layout == Layout::lightnessChromaPlane)
+        {
+            // vivid colours of every hue, still inside sRGB
+            const float stripLightness = 0.7f;
+            PickerConversion::CIELCHtoRGB(stripLightness, 0.9f * CIELCHConversionTables::getMaxChroma(stripLightness, value), value, pixel);
+        }
+        else
+        {
+            PickerConversion::CIELCHtoRGB(1.0f - value, 0.0f, 0.0f, pixel);
+        }
+
+        for (int x = 0; x < data.width; ++x)
+            pixels[x] = pixel;
+
+        CIELCHImageLine::write(data, y, pixels);
+    }
+}
+
+void CIELCHColourPicker::startPlaneRender()
+{
+    if (planeArea.isEmpty())
+    {
+        deliveredGeneration = ++renderGeneration;
+        planeImage = Image();
+        return;
+    }
+
+    // older renders see the new generation and stop
+    renderPool.addJob(new PlaneRenderer(*this, planeArea.getWidth(), planeArea.getHeight()), true);
+}
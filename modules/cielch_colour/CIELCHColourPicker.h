@@ -0,0 +1,149 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+#ifndef CIELCHColourPicker_H_INCLUDED
+#define CIELCHColourPicker_H_INCLUDED
+
+//==============================================================================
+/**
+A colour picker for the CIE LCH colour space.
+
+The picker shows a plane of colours and a strip for the remaining axis, in one of two layouts:
+- a lightness-chroma plane with a hue strip, or
+- a chroma-hue wheel with a lightness strip.
+
+Colours outside of sRGB are drawn faded, and a line marks the boundary of the sRGB gamut.
+
+The plane and its gamut boundary are rendered into an image on a background thread, only when the
+value of the strip (the fixed axis of the plane) or the size changes. While a new plane is being
+rendered, the previous one stays visible; renders which are overtaken by a newer value are dropped.
+Moving the cursor only repaints the cursor's area, so dragging costs a blit of the cached plane and
+the cursor.
+
+The picker sends a change message when the colour changes, like ColourSelector.
+
+This class is only available if the juce_gui_basics module is used.
+
+Here an example on how to use the class:
+@code
+picker.setCurrentColour(CIELCHColour(Colours::orange), dontSendNotification);
+picker.addChangeListener(this);
+addAndMakeVisible(picker);
+
+void MyComponent::changeListenerCallback(ChangeBroadcaster*)
+{
+    button.setColour(TextButton::buttonColourId, picker.getCurrentColour().getJuceColour());
+}
+@endcode
+*/
+class CIELCHColourPicker  : public Component,
+                            public ChangeBroadcaster
+{
+public:
+
+    enum class Layout
+    {
+        lightnessChromaPlane,   /**< lightness upwards, chroma to the right, and a hue strip */
+        chromaHueWheel          /**< hue around and chroma outwards, and a lightness strip */
+    };
+
+    explicit CIELCHColourPicker(Layout layout = Layout::lightnessChromaPlane);
+    ~CIELCHColourPicker();
+
+    void setLayout(Layout newLayout);
+    Layout getLayout() const noexcept                   { return layout; }
+
+    //==============================================================================
+    /** Returns the current colour, clipped to sRGB if it is imaginary. */
+    CIELCHColour getCurrentColour() const;
+
+    /** Sets the current colour. */
+    void setCurrentColour(const CIELCHColour& colour, NotificationType notification = sendNotification);
+
+    /** Returns the current colour in CIE LCH, all values in the range 0...1. */
+    void getCurrentCIELCH(float& L, float& C, float& H) const noexcept;
+
+    /** Sets the current colour in CIE LCH, all values in the range 0...1.
+    The colour may be imaginary, see isCurrentColourImaginary().
+    */
+    void setCurrentCIELCH(float L, float C, float H, NotificationType notification = sendNotification);
+
+    /** Returns true if the current colour is outside of sRGB. */
+    bool isCurrentColourImaginary() const;
+
+    /** Returns true if no render of the plane is pending, so the plane shows the current value
+    of the strip. The renders are handed over on the message thread, so this only becomes true
+    while messages are dispatched. It is meant for tests and benchmarks.
+    */
+    bool isPlaneUpToDate() const noexcept;
+
+    //==============================================================================
+    /** @internal */
+    void paint(Graphics& g) override;
+    /** @internal */
+    void resized() override;
+    /** @internal */
+    void mouseDown(const MouseEvent& e) override;
+    /** @internal */
+    void mouseDrag(const MouseEvent& e) override;
+
+private:
+
+    class PlaneRenderer;
+
+    float getFixedValue() const noexcept;
+    Point<float> getCursorPosition() const noexcept;
+    Rectangle<int> getCursorBounds() const noexcept;
+    void setFromPlane(Point<float> position, NotificationType notification);
+    void setFromStrip(float y, NotificationType notification);
+    void renderStrip();
+    void startPlaneRender();
+
+    Layout layout;
+    float lightness = 0.6f, chroma = 0.3f, hue = 0.1f;
+
+    Rectangle<int> planeArea, stripArea;
+    Image planeImage, stripImage;
+    bool draggingStrip = false;
+
+    std::atomic<int> renderGeneration { 0 };
+    int deliveredGeneration = 0;
+
+    // destroyed first, so that no render is still running when the rest goes away
+    ThreadPool renderPool { 1 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CIELCHColourPicker)
+};
+
+
+#endif  // CIELCHColourPicker_H_INCLUDED
@@ -0,0 +1,445 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+namespace
+{
+    /** The std maths functions, used for the tables created at run time and as the reference */
+    struct RuntimeMath
+    {
+        static double pow(double x, double y) noexcept  { return std::pow(x, y); }
+        static float powf(float x, float y) noexcept    { return std::pow(x, y); }
+        static double cbrt(double x) noexcept           { return std::cbrt(x); }
+        static double sin(double x) noexcept            { return std::sin(x); }
+        static double atan(double x) noexcept           { return std::atan(x); }
+    };
+
+   #if CIELCH_CONSTEXPR_TABLES
+    // the table functions and constructors are only constexpr with CIELCH_CONSTEXPR_TABLES, as
+    // their loops and local variables need C++14 constexpr
+    #define CIELCH_TABLE_CONSTEXPR  constexpr
+
+    /** Maths functions which can be evaluated by the compiler. They are accurate to a few units in
+    the last place of a double, far more than the float tables need. Only the ranges used by the
+    tables are supported.
+    */
+    struct ConstexprMath
+    {
+        static constexpr double ln2 = 0.693147180559945309417;
+        static constexpr double pi = 3.14159265358979323846;
+
+        /** x > 0 */
+        static constexpr double log(double x) noexcept
+        {
+            // x = m * 2^k with m in [1, 2), then ln(m) = 2 atanh((m - 1) / (m + 1))
+            int k = 0;
+
+            while (x >= 2.0) { x *= 0.5; ++k; }
+            while (x < 1.0)  { x *= 2.0; --k; }
+
+            const double z = (x - 1.0) / (x + 1.0);
+            const double z2 = z * z;
+            double term = z, sum = 0.0;
+
+            for (int n = 1; n < 40; n += 2)
+            {
+                sum += term / n;
+                term *= z2;
+            }
+
+            return 2.0 * sum + k * ln2;
+        }
+
+        static constexpr double exp(double x) noexcept
+        {
+            // x = k ln2 + r with |r| <= ln2 / 2, then e^x = 2^k e^r
+            const int k = (int) (x / ln2 + (x < 0.0 ? -0.5 : 0.5));
+            const double r = x - k * ln2;
+            double term = 1.0, sum = 1.0;
+
+            for (int n = 1; n < 19; ++n)
+            {
+                term *= r / n;
+                sum += term;
+            }
+
+            for (int i = 0; i < k; ++i)  sum *= 2.0;
+            for (int i = 0; i > k; --i)  sum *= 0.5;
+
+            return sum;
+        }
+
+        /** x >= 0 */
+        static constexpr double pow(double x, double y) noexcept  { return x > 0.0 ? exp(y * log(x)) : 0.0; }
+
+        /** x >= 0, rounded like a correctly rounded std::pow for floats */
+        static constexpr float powf(float x, float y) noexcept    { return (float) pow(x, y); }
+
+        /** x >= 0 */
+        static constexpr double cbrt(double x) noexcept           { return x > 0.0 ? exp(log(x) / 3.0) : 0.0; }
+
+        /** -2 pi <= x <= 2 pi */
+        static constexpr double sin(double x) noexcept
+        {
+            if (x > pi)   x -= 2.0 * pi;
+            if (x < -pi)  x += 2.0 * pi;
+
+            const double x2 = x * x;
+            double term = x, sum = x;
+
+            for (int n = 2; n < 34; n += 2)
+            {
+                term *= -x2 / (n * (n + 1));
+                sum += term;
+            }
+
+            return sum;
+        }
+
+        /** 0 <= x <= 1 */
+        static constexpr double atan(double x) noexcept
+        {
+            // atan(x) = pi / 4 + atan((x - 1) / (x + 1)), which keeps the series argument small
+            const bool shifted = x > 0.41421356;
+            const double z = shifted ? (x - 1.0) / (x + 1.0) : x;
+            const double z2 = z * z;
+            double term = z, sum = 0.0;
+
+            for (int n = 1; n < 48; n += 2)
+            {
+                sum += term / n;
+                term *= -z2;
+            }
+
+            return shifted ? pi / 4.0 + sum : sum;
+        }
+    };
+   #else
+    #define CIELCH_TABLE_CONSTEXPR
+   #endif
+
+    //==============================================================================
+    // the functions of the tables, for x in the range 0...1
+
+    template <class Math>
+    CIELCH_TABLE_CONSTEXPR double linearisation(double x) noexcept
+    {
+        //the same float calculation as CIELCHColour::invGammaCorrection, so that the exact
+        //line conversions give exactly the same results as CIELCHColour
+        const float g = (float) (int) (x * 255.0 + 0.5) / 255.0f;
+
+        return g > 0.04045f ? Math::powf((g + 0.055f) / 1.055f, 2.4f) * 100.0f
+                            : g / 12.92f * 100.0f;
+    }
+
+    template <class Math>
+    CIELCH_TABLE_CONSTEXPR double gammaCompression(double g) noexcept
+    {
+        return g > 0.0031308 ? 1.055 * Math::pow(g, 1.0 / 2.4) - 0.055
+                             : 12.92 * g;
+    }
+
+    template <class Math>
+    CIELCH_TABLE_CONSTEXPR double cubeRoot(double t) noexcept        { return Math::cbrt(t); }
+
+    template <class Math>
+    CIELCH_TABLE_CONSTEXPR double sinOfTurns(double x) noexcept      { return Math::sin(2.0 * 3.14159265358979323846 * x); }
+
+    template <class Math>
+    CIELCH_TABLE_CONSTEXPR double arcTanInTurns(double t) noexcept   { return Math::atan(t) / (2.0 * 3.14159265358979323846); }
+
+    //==============================================================================
+    // the gamut boundary, for the max chroma table
+
+    /** Returns the largest chroma C for which all colours with the chroma 0...C are inside sRGB,
+    calculated like CIELCHConversion::CIELabtoRGB. The hue is given by its cosine and sine.
+    Near the cusp of yellow a band of higher chromas is inside sRGB again, but it can't be reached
+    by reducing the chroma, so it is left out.
+    */
+    CIELCH_TABLE_CONSTEXPR double maxChromaOf(double L, double cosHue, double sinHue) noexcept
+    {
+        const double fy = (L * 100.0 + 16.0) / 116.0;
+        const double Y = fy > 6.0 / 29.0 ? fy * fy * fy : (fy - 16.0 / 116.0) / 7.787;
+        // The linear RGB values must be inside 0...1, apart from the rounding of the matrix, which
+        // gives 1.00008 for white. So the tolerance of the imaginary colours (half an 8-bit step)
+        // is left for the interpolation of the table.
+        const double minLinear = 0.0;
+        const double maxLinear = 1.0001;
+
+        // Steps of 1/8 up to the first chroma outside, then a binary search down to 1/8 / 2^12.
+        // Everything is in one loop, as GCC's constexpr evaluation stores the result of every
+        // function call.
+        double inside = 0.0, outside = 2.0;
+        int numBisections = 0;
+
+        for (int i = 1; numBisections < 12; ++i)
+        {
+            double C = i / 8.0;
+
+            if (outside <= 1.0)
+            {
+                C = 0.5 * (inside + outside);
+                ++numBisections;
+            }
+            else if (i > 8)
+            {
+                return 1.0;
+            }
+
+            const double fx = C * 134.0 * cosHue / 500.0 + fy;
+            const double fz = fy - C * 134.0 * sinHue / 200.0;
+            const double X = 0.95047 * (fx > 6.0 / 29.0 ? fx * fx * fx : (fx - 16.0 / 116.0) / 7.787);
+            const double Z = 1.08883 * (fz > 6.0 / 29.0 ? fz * fz * fz : (fz - 16.0 / 116.0) / 7.787);
+
+            const double R = X *  3.2406 + Y * -1.5372 + Z * -0.4986;
+            const double G = X * -0.9689 + Y *  1.8758 + Z *  0.0415;
+            const double B = X *  0.0557 + Y * -0.2040 + Z *  1.0570;
+
+            if (R >= minLinear && R <= maxLinear && G >= minLinear && G <= maxLinear && B >= minLinear && B <= maxLinear)
+                inside = C;
+            else
+                outside = C;
+        }
+
+        return inside;
+    }
+
+    /** The table of CIELCHConversionTables::getMaxChromaTable */
+    template <class Math>
+    struct MaxChromaTable
+    {
+        enum
+        {
+            numHues = CIELCHConversionTables::maxChromaHues,
+            numSteps = CIELCHConversionTables::maxChromaSteps,
+            rowSize = 2 * numSteps + 4
+        };
+
+        CIELCH_TABLE_CONSTEXPR MaxChromaTable() noexcept : values()
+        {
+            for (int hue = 0; hue < numHues; ++hue)
+            {
+                const double turns = (double) hue / numHues;
+                const double sinHue = sinOfTurns<Math>(turns);
+                const double cosHue = sinOfTurns<Math>(turns < 0.75 ? turns + 0.25 : turns - 0.75);
+
+                // The max chroma rises from black to the cusp and falls from there to white, so the
+                // cusp is found with a golden section search. The function jumps down right after the
+                // cusp of yellow, so the cusp is the best value found, not the middle of the interval.
+                const double golden = 0.6180339887498949;
+                double low = 0.0, high = 1.0;
+                double lower = high - golden * (high - low), upper = low + golden * (high - low);
+                double lowerC = maxChromaOf(lower, cosHue, sinHue), upperC = maxChromaOf(upper, cosHue, sinHue);
+
+                for (int i = 0; i < 16; ++i)
+                {
+                    if (lowerC < upperC)
+                    {
+                        low = lower;
+                        lower = upper;
+                        lowerC = upperC;
+                        upper = low + golden * (high - low);
+                        upperC = maxChromaOf(upper, cosHue, sinHue);
+                    }
+                    else
+                    {
+                        high = upper;
+                        upper = lower;
+                        upperC = lowerC;
+                        lower = high - golden * (high - low);
+                        lowerC = maxChromaOf(lower, cosHue, sinHue);
+                    }
+                }
+
+                const double cuspL = lowerC < upperC ? upper : lower;
+                const double cuspC = lowerC < upperC ? upperC : lowerC;
+
+                float* row = values + hue * rowSize;
+                row[0] = (float) cuspL;
+                row[1] = (float) cuspC;
+
+                for (int i = 0; i <= numSteps; ++i)
+                {
+                    const double t = (double) i / numSteps;
+                    row[2 + i] = (float) (maxChromaOf(t * cuspL, cosHue, sinHue) / cuspC);
+                    row[3 + numSteps + i] = (float) (maxChromaOf(cuspL + t * (1.0 - cuspL), cosHue, sinHue) / cuspC);
+                }
+            }
+        }
+
+        float values[numHues * rowSize];
+    };
+
+    //==============================================================================
+    /** A table with numIntervals + 1 entries, filled with function(i / numIntervals) */
+    template <double (*function)(double), int numIntervals>
+    struct Table
+    {
+        CIELCH_TABLE_CONSTEXPR Table() noexcept : values()
+        {
+            for (int i = 0; i <= numIntervals; ++i)
+                values[i] = (float) function((double) i / numIntervals);
+        }
+
+        float values[numIntervals + 1];
+    };
+
+    // the linearisation table has one entry per 8-bit value, the others are interpolated
+    template <class Math> using LinearisationTable      = Table<&linearisation<Math>, 255>;
+    template <class Math> using GammaCompressionTable   = Table<&gammaCompression<Math>, CIELCHConversionTables::tableSize>;
+    template <class Math> using CubeRootTable           = Table<&cubeRoot<Math>, CIELCHConversionTables::tableSize>;
+    template <class Math> using SinTable                = Table<&sinOfTurns<Math>, CIELCHConversionTables::tableSize>;
+    template <class Math> using ArcTanTable             = Table<&arcTanInTurns<Math>, CIELCHConversionTables::tableSize>;
+
+   #if CIELCH_CONSTEXPR_TABLES
+    constexpr LinearisationTable<ConstexprMath>     linearisationTable;
+    constexpr GammaCompressionTable<ConstexprMath>  gammaCompressionTable;
+    constexpr CubeRootTable<ConstexprMath>          cubeRootTable;
+    constexpr SinTable<ConstexprMath>               sinTable;
+    constexpr ArcTanTable<ConstexprMath>            arcTanTable;
+    constexpr MaxChromaTable<ConstexprMath>         maxChromaTable;
+
+    static_assert(linearisationTable.values[0] == 0.0f && linearisationTable.values[255] == 100.0f,
+                  "the linearisation table must span 0...100");
+    static_assert(gammaCompressionTable.values[CIELCHConversionTables::tableSize] > 0.99999f
+                   && gammaCompressionTable.values[CIELCHConversionTables::tableSize] < 1.00001f,
+                  "the gamma compression table must end at 1");
+    static_assert(cubeRootTable.values[CIELCHConversionTables::tableSize / 8] == 0.5f,
+                  "the cube root table must contain the cube root of 1/8");
+    static_assert(maxChromaTable.values[1] > 0.5f && maxChromaTable.values[2] < 0.01f,
+                  "the max chroma table must start with the cusp of red and nearly no chroma at black");
+
+    #define CIELCH_TABLE(type, name)  name.values
+   #else
+    // the tables are created the first time they are used
+    #define CIELCH_TABLE(type, name)  [] { static const type<RuntimeMath> table; return table.values; }()
+   #endif
+
+    template <class TableType>
+    double getMaxDeviation(const float* table) noexcept
+    {
+        const TableType reference;
+        const int numEntries = (int) numElementsInArray(reference.values);
+        double largest = 0.0, deviation = 0.0;
+
+        for (int i = 0; i < numEntries; ++i)
+        {
+            largest = jmax(largest, std::abs((double) reference.values[i]));
+            deviation = jmax(deviation, std::abs((double) table[i] - (double) reference.values[i]));
+        }
+
+        return deviation / largest;
+    }
+}
+
+const float* CIELCHConversionTables::getLinearisationTable() noexcept
+{
+    return CIELCH_TABLE(LinearisationTable, linearisationTable);
+}
+
+const float* CIELCHConversionTables::getGammaCompressionTable() noexcept
+{
+    return CIELCH_TABLE(GammaCompressionTable, gammaCompressionTable);
+}
+
+const float* CIELCHConversionTables::getCubeRootTable() noexcept
+{
+    return CIELCH_TABLE(CubeRootTable, cubeRootTable);
+}
+
+const float* CIELCHConversionTables::getSinTable() noexcept
+{
+    return CIELCH_TABLE(SinTable, sinTable);
+}
+
+const float* CIELCHConversionTables::getArcTanTable() noexcept
+{
+    return CIELCH_TABLE(ArcTanTable, arcTanTable);
+}
+
+const float* CIELCHConversionTables::getMaxChromaTable() noexcept
+{
+    return CIELCH_TABLE(MaxChromaTable, maxChromaTable);
+}
+
+#undef CIELCH_TABLE
+#undef CIELCH_TABLE_CONSTEXPR
+
+double CIELCHConversionTables::getMaxDeviationFromReference()
+{
+    const double deviations[] =
+    {
+        getMaxDeviation<LinearisationTable<RuntimeMath>>(getLinearisationTable()),
+        getMaxDeviation<GammaCompressionTable<RuntimeMath>>(getGammaCompressionTable()),
+        getMaxDeviation<CubeRootTable<RuntimeMath>>(getCubeRootTable()),
+        getMaxDeviation<SinTable<RuntimeMath>>(getSinTable()),
+        getMaxDeviation<ArcTanTable<RuntimeMath>>(getArcTanTable()),
+        getMaxDeviation<MaxChromaTable<RuntimeMath>>(getMaxChromaTable())
+    };
+
+    return *std::max_element(deviations, deviations + numElementsInArray(deviations));
+}
+
+//==============================================================================
+namespace
+{
+    static_assert(CIELCH_DEFAULT_PRECISION >= (int) CIELCHPrecision::exact
+                   && CIELCH_DEFAULT_PRECISION <= (int) CIELCHPrecision::fastest,
+                  "CIELCH_DEFAULT_PRECISION must be 0 (exact), 1 (fast) or 2 (fastest)");
+
+    std::atomic<int> defaultPrecision { CIELCH_DEFAULT_PRECISION };
+}
+
+void CIELCHConverter::setDefaultPrecision(CIELCHPrecision newPrecision) noexcept
+{
+    defaultPrecision.store((int) newPrecision);
+}
+
+CIELCHPrecision CIELCHConverter::getDefaultPrecision() noexcept
+{
+    return (CIELCHPrecision) defaultPrecision.load();
+}
+
+//==============================================================================
+CIELCHConverter::CIELCHConverter(CIELCHPrecision p) noexcept
+    : precision(p)
+{
+    const CIELCHKernels::Functions& functions = CIELCHKernels::getFunctions(precision);
+
+    rgbToLab = functions.RGBtoCIELab;
+    labToRgb = functions.CIELabtoRGB;
+    labToLch = functions.CIELabtoCIELCH;
+    lchToLab = functions.CIELCHtoCIELab;
+    rgbToLch = functions.RGBtoCIELCH;
+    lchToRgb = functions.CIELCHtoRGB;
+}
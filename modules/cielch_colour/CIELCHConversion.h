@@ -0,0 +1,672 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+#ifndef CIELCHConversion_H_INCLUDED
+#define CIELCHConversion_H_INCLUDED
+
+//==============================================================================
+/**
+The speed/accuracy trade-off of the CIE LCH conversions.
+
+The Delta E is the largest CIE76 Delta E of RGBtoCIELab compared to the exact conversion. The
+pixel errors count 8-bit sRGB results which differ from the exact conversion: once for the round trip
+sRGB -> CIE LCH -> sRGB over all 16.7 million colours, and once for CIELCHtoRGB over a grid of 16
+million CIE LCH values. They are never more than one step off. Throughput is for the round trip on
+lines of 4096 pixels, single threaded, x86-64, GCC -O3, with the generic and with the AVX2 kernels
+of CIELCHKernels.
+
+Precision | max Delta E | round trip errors | CIELCHtoRGB errors | ns/pixel (generic) | ns/pixel (AVX2)
+--------- | ----------- | ----------------- | ------------------ | ------------------ | ---------------
+exact     | 0           | 0                 | 0                  | 190                | 190
+fast      | 0.0001      | 0                 | 0.018 %            | 33                 | 21
+fastest   | 0.0024      | 0                 | 0.018 %            | 31                 | 24
+
+Use exact for exporting and testing, and fast or fastest for drawing user interfaces.
+
+The precision applies to the line conversions, to the functions of CIELCHColour (fromCIELCH,
+getCIELCH, withCIEChroma, CIELighter, CIEDarker and the others) and to the image operations,
+e.g. CIELabPlaneTransform::applyTo and CIELCHImageStatistics. Where none is passed, they use the
+default precision: exact, unless CIELCH_DEFAULT_PRECISION or CIELCHConverter::setDefaultPrecision
+change it. The static conversions of CIELCHColour (RGBtoCIELCH, CIELCHtoRGB and the others)
+are always exact.
+@see CIELCHConversion, CIELCHConverter
+*/
+enum class CIELCHPrecision
+{
+    exact,      /**< std::pow, std::atan2, std::cos and std::sin. Same results as the CIELCHColour functions. */
+    fast,       /**< Lookup tables for the sRGB gamma, Newton iterations for the cube root and CIELCHFastMath for the trigonometry. */
+    fastest     /**< Interpolated lookup tables for the gamma, the cube root and the trigonometry. */
+};
+
+//==============================================================================
+/**
+Lookup tables used by CIELCHConversion.
+The tables are created at compile time, or the first time they are used, see CIELCH_CONSTEXPR_TABLES.
+*/
+struct CIELCHConversionTables
+{
+    /** The size of the tables, which are indexed with a value in the range 0...1 */
+    enum { tableSize = 4096 };
+
+    /** The number of hues of the max chroma table, and of its lightness steps on each side of the cusp */
+    enum { maxChromaHues = 128, maxChromaSteps = 16 };
+
+    /** 256 entries: the linear sRGB value (0...100) of each 8-bit sRGB value */
+    static const float* getLinearisationTable() noexcept;
+
+    /** tableSize + 1 entries: the sRGB gamma compression of (i / tableSize), to be interpolated */
+    static const float* getGammaCompressionTable() noexcept;
+
+    /** tableSize + 1 entries: the cube root of (i / tableSize), to be interpolated */
+    static const float* getCubeRootTable() noexcept;
+
+    /** tableSize + 1 entries: sin(2 pi i / tableSize), i.e. one full turn, to be interpolated */
+    static const float* getSinTable() noexcept;
+
+    /** tableSize + 1 entries: atan(i / tableSize) / (2 pi), i.e. in turns, to be interpolated */
+    static const float* getArcTanTable() noexcept;
+
+    /** maxChromaHues rows of 2 * maxChromaSteps + 4 entries, one for each hue (i / maxChromaHues):
+    the lightness and chroma of the cusp, where the chroma inside sRGB is largest, followed by the
+    largest chroma relative to the cusp chroma at maxChromaSteps + 1 lightnesses from black up to
+    the cusp, and at maxChromaSteps + 1 lightnesses from the cusp up to white. @see getMaxChroma
+    */
+    static const float* getMaxChromaTable() noexcept;
+
+    /** Linearly interpolates a table with tableSize + 1 entries. x must be in the range 0...1,
+    values slightly above 1 are extrapolated from the last two entries.
+    */
+    static float lookup(const float* table, float x) noexcept
+    {
+        const float pos = x * (float) tableSize;
+        const int index = jmin((int) pos, (int) tableSize - 1);
+        const float fraction = pos - (float) index;
+        return table[index] + fraction * (table[index + 1] - table[index]);
+    }
+
+    /** Returns the largest chroma (0...1) up to which the colours with the given lightness and hue
+    (both 0...1) are not imaginary, interpolated from getMaxChromaTable(). Reducing the chroma of
+    an imaginary colour to this value maps it into the gamut without changing its lightness or hue.
+
+    Between the table entries the result is within 0.001 of the exact boundary for 94% of all
+    lightnesses and hues, and within 0.005 for 98%. The boundary has a sharp cusp for every hue,
+    and a step at the cusp of yellow, so in a band of about 0.1 lightness around the cusps it can
+    be off by more, in both directions: 0.2% of the colours with the returned chroma are still
+    imaginary, by at most 0.04 chroma. Where a colour has to be inside sRGB, convert it and reduce
+    the chroma further while it is flagged as imaginary.
+    */
+    static float getMaxChroma(float L, float H) noexcept
+    {
+        const float* table = getMaxChromaTable();
+        const int rowSize = 2 * maxChromaSteps + 4;
+
+        const float hue = (H - std::floor(H)) * (float) maxChromaHues;
+        const int index = jmin((int) hue, (int) maxChromaHues - 1);
+        const float hueFraction = hue - (float) index;
+        const float* row1 = table + index * rowSize;
+        const float* row2 = table + ((index + 1) % maxChromaHues) * rowSize;
+
+        // the cusp is interpolated first, and the lightness is taken relative to it, so that the
+        // interpolation between the hues doesn't cut across the cusps
+        const float cuspL = row1[0] + hueFraction * (row2[0] - row1[0]);
+        const float cuspC = interpolateChroma(row1[1], row2[1], hueFraction);
+        const float lightness = jlimit(0.0f, 1.0f, L);
+
+        const bool belowCusp = lightness <= cuspL;
+        const float t = belowCusp ? lightness / cuspL : (lightness - cuspL) / (1.0f - cuspL);
+        const int offset = belowCusp ? 2 : 3 + maxChromaSteps;
+
+        const float step = t * (float) maxChromaSteps;
+        const int i = jmin((int) step, (int) maxChromaSteps - 1);
+        const float fraction = step - (float) i;
+        const float relative1 = row1[offset + i] + fraction * (row1[offset + i + 1] - row1[offset + i]);
+        const float relative2 = row2[offset + i] + fraction * (row2[offset + i + 1] - row2[offset + i]);
+
+        return cuspC * interpolateChroma(relative1, relative2, hueFraction);
+    }
+
+    /** Compares every entry of every table with the same function calculated at run time with the
+    std maths functions (std::pow, std::cbrt...).
+    @returns the largest difference, relative to the largest value of the table. Tables created at
+    compile time differ by at most a rounding of the float value, i.e. about 6e-8.
+    */
+    static double getMaxDeviationFromReference();
+
+private:
+    /** Interpolates 1 / chroma between two hues. Unlike a linear interpolation, this follows a
+    straight gamut boundary between the two hues, instead of cutting outside of it.
+    */
+    static float interpolateChroma(float chroma1, float chroma2, float fraction) noexcept
+    {
+        const float denominator = chroma2 + fraction * (chroma1 - chroma2);
+        return denominator > 0.0f ? chroma1 * chroma2 / denominator : 0.0f;
+    }
+};
+
+//==============================================================================
+/**
+Converts lines of colours between sRGB, CIE Lab and CIE LCH with a given precision.
+
+The precision is a template parameter, so there is no run-time overhead for choosing it.
+If the precision is only known at run time, use CIELCHConverter instead.
+
+Units are the same as in the CIELCHColour class: CIE Lab values are in the range 0...100 for L,
+CIE LCH values are all in the range 0...1. The pixels are not premultiplied. Like in CIELCHColour,
+colours which do not fit into sRGB ("imaginary" colours) are clipped.
+
+Here an example on how to use the class:
+@code
+typedef CIELCHConversion<CIELCHPrecision::fastest> Conversion;
+Conversion::RGBtoCIELCH(pixels, L, C, H, numPixels);
+for (int i = 0; i < numPixels; ++i)
+    C[i] *= 0.5f;
+Conversion::CIELCHtoRGB(L, C, H, pixels, numPixels);
+@endcode
+*/
+template <CIELCHPrecision precision>
+struct CIELCHConversion
+{
+    /** Convert a line of pixels from sRGB to CIE Lab. @see CIELCHColour::RGBtoCIELab */
+    static void RGBtoCIELab(const PixelARGB* pixels, float* L, float* a, float* b, int numPixels) noexcept
+    {
+        const float* linear = CIELCHConversionTables::getLinearisationTable();
+        const float* cubeRoot = CIELCHConversionTables::getCubeRootTable();
+
+        // The table lookups only write to local arrays: if the loops wrote to L, a or b, the compiler
+        // would have to assume that they might overwrite the tables, and it couldn't vectorise them.
+        const int blockSize = 256;
+        float R[blockSize], G[blockSize], B[blockSize];
+        float X[blockSize], Y[blockSize], Z[blockSize];
+
+        for (int start = 0; start < numPixels; start += blockSize)
+        {
+            const int num = jmin(blockSize, numPixels - start);
+
+            for (int i = 0; i < num; ++i)
+            {
+                R[i] = linear[pixels[start + i].getRed()];
+                G[i] = linear[pixels[start + i].getGreen()];
+                B[i] = linear[pixels[start + i].getBlue()];
+            }
+
+            //Observer = 2 degrees, Illuminant = D65 (see CIELCHColour::RGBtoXYZ and CIELCHColour::XYZtoCIELab)
+            for (int i = 0; i < num; ++i)
+            {
+                X[i] = f((R[i] * 0.4124f + G[i] * 0.3576f + B[i] * 0.1805f) / 95.047f, cubeRoot);
+                Y[i] = f((R[i] * 0.2126f + G[i] * 0.7152f + B[i] * 0.0722f) / 100.000f, cubeRoot);
+                Z[i] = f((R[i] * 0.0193f + G[i] * 0.1192f + B[i] * 0.9505f) / 108.883f, cubeRoot);
+            }
+
+            for (int i = 0; i < num; ++i)
+            {
+                L[start + i] = (116.0f * Y[i]) - 16.0f;
+                a[start + i] = 500.0f * (X[i] - Y[i]);
+                b[start + i] = 200.0f * (Y[i] - Z[i]);
+            }
+        }
+    }
+
+    /** Convert a line of CIE Lab values to sRGB. The alpha of the pixels is left untouched.
+    If imaginary isn't null, it receives numPixels flags of the colours which had to be clipped.
+    @returns the number of imaginary colours, which had to be clipped.
+    @see CIELCHColour::CIELabtoRGB
+    */
+    static int CIELabtoRGB(const float* L, const float* a, const float* b, PixelARGB* pixels, int numPixels,
+                           bool* imaginary = nullptr) noexcept
+    {
+        int numImaginary = 0;
+
+        if (precision == CIELCHPrecision::exact)
+        {
+            for (int i = 0; i < numPixels; ++i)
+            {
+                //see CIELCHColour::CIELabtoXYZ and CIELCHColour::XYZtoRGB
+                const float fy = (L[i] + 16.0f) / 116.0f;
+                const float X = 95.047f * fInverse(a[i] / 500.0f + fy) / 100.0f;
+                const float Y = 100.000f * fInverse(fy) / 100.0f;
+                const float Z = 108.883f * fInverse(fy - b[i] / 200.0f) / 100.0f;
+
+                float R = gammaCorrection(X *  3.2406f + Y * -1.5372f + Z * -0.4986f);
+                float G = gammaCorrection(X * -0.9689f + Y *  1.8758f + Z *  0.0415f);
+                float B = gammaCorrection(X *  0.0557f + Y * -0.2040f + Z *  1.0570f);
+
+                //see CIELCHColour::XYZtoRGB for the tolerance
+                const float tolerance = 0.5f / 255.0f;
+
+                const bool outside = (R < -tolerance || R > 1.0f + tolerance)
+                                      || (G < -tolerance || G > 1.0f + tolerance)
+                                      || (B < -tolerance || B > 1.0f + tolerance);
+                numImaginary += (int) outside;
+
+                if (imaginary != nullptr)
+                    imaginary[i] = outside;
+
+                R = jlimit(0.0f, 1.0f, R);
+                G = jlimit(0.0f, 1.0f, G);
+                B = jlimit(0.0f, 1.0f, B);
+
+                pixels[i].setARGB(pixels[i].getAlpha(), toUint8(R), toUint8(G), toUint8(B));
+            }
+
+            return numImaginary;
+        }
+
+        // The linear RGB values and the gamma are calculated in separate loops. Otherwise the
+        // compiler specialises the table lookups for the clipped values, and the branches this
+        // creates stop the vectoriser.
+        const float* gamma = CIELCHConversionTables::getGammaCompressionTable();
+        const int blockSize = 256;
+        float linearR[blockSize], linearG[blockSize], linearB[blockSize];
+        bool outside[blockSize];
+
+        // half an 8-bit step outside of 0...1 (see CIELCHColour::XYZtoRGB), before the gamma
+        const float minLinear = -0.5f / 255.0f / 12.92f;
+        const float maxLinear = 1.0044664f;
+
+        for (int start = 0; start < numPixels; start += blockSize)
+        {
+            const int num = jmin(blockSize, numPixels - start);
+
+            for (int i = 0; i < num; ++i)
+            {
+                const float fy = (L[start + i] + 16.0f) / 116.0f;
+                const float X = 0.95047f * fInverse(a[start + i] / 500.0f + fy);
+                const float Y = fInverse(fy);
+                const float Z = 1.08883f * fInverse(fy - b[start + i] / 200.0f);
+
+                const float R = X *  3.2406f + Y * -1.5372f + Z * -0.4986f;
+                const float G = X * -0.9689f + Y *  1.8758f + Z *  0.0415f;
+                const float B = X *  0.0557f + Y * -0.2040f + Z *  1.0570f;
+
+                // the gamma maps 0...1 onto 0...1, so the clipping can be done before it
+                linearR[i] = jmax(0.0f, jmin(1.0f, R));
+                linearG[i] = jmax(0.0f, jmin(1.0f, G));
+                linearB[i] = jmax(0.0f, jmin(1.0f, B));
+                outside[i] = (R < minLinear) | (R > maxLinear)
+                              | (G < minLinear) | (G > maxLinear)
+                              | (B < minLinear) | (B > maxLinear);
+                numImaginary += (int) outside[i];
+            }
+
+            if (imaginary != nullptr)
+                std::copy(outside, outside + num, imaginary + start);
+
+            for (int i = 0; i < num; ++i)
+            {
+                PixelARGB& pixel = pixels[start + i];
+                pixel.setARGB(pixel.getAlpha(),
+                              toUint8(CIELCHConversionTables::lookup(gamma, linearR[i])),
+                              toUint8(CIELCHConversionTables::lookup(gamma, linearG[i])),
+                              toUint8(CIELCHConversionTables::lookup(gamma, linearB[i])));
+            }
+        }
+
+        return numImaginary;
+    }
+
+    /** Convert a line of CIE Lab a and b values to CIE LCH chroma and hue, both in the range 0...1.
+    The lightness is the same in both colour spaces, apart from the scaling.
+    The conversion can be done in place, i.e. C may be the same array as a, and H the same as b.
+    */
+    static void CIELabtoCIELCH(const float* a, const float* b, float* C, float* H, int numValues) noexcept
+    {
+        if (precision == CIELCHPrecision::exact)
+        {
+            for (int i = 0; i < numValues; ++i)
+            {
+                const float ai = a[i];
+                const float bi = b[i];
+                C[i] = std::sqrt(ai * ai + bi * bi) / 134.0f;
+                H[i] = hueOf(ai, bi, nullptr);
+            }
+
+            return;
+        }
+
+        // the hues are calculated into a local array first, so that both loops can be vectorised
+        // (see RGBtoCIELab)
+        const float* arcTan = CIELCHConversionTables::getArcTanTable();
+        const int blockSize = 256;
+        float hue[blockSize];
+
+        for (int start = 0; start < numValues; start += blockSize)
+        {
+            const int num = jmin(blockSize, numValues - start);
+
+            if (precision == CIELCHPrecision::fast)
+                CIELCHFastMath::atan2Turns(b + start, a + start, hue, num);
+            else
+                for (int i = 0; i < num; ++i)
+                    hue[i] = hueOf(a[start + i], b[start + i], arcTan);
+
+            for (int i = start; i < start + num; ++i)
+            {
+                C[i] = CIELCHFastMath::hypot(a[i], b[i]) / 134.0f;
+                H[i] = hue[i - start];
+            }
+        }
+    }
+
+    /** Convert a line of CIE LCH chroma and hue values (both in the range 0...1) to CIE Lab a and b values.
+    Like in CIELCHColour::CIELCHtoRGB, the chroma is limited to the range 0...1.
+    */
+    static void CIELCHtoCIELab(const float* C, const float* H, float* a, float* b, int numValues) noexcept
+    {
+        if (precision == CIELCHPrecision::exact)
+        {
+            for (int i = 0; i < numValues; ++i)
+            {
+                const float chroma = jlimit(0.0f, 1.0f, C[i]) * 134.0f;
+                const float hue = H[i] * 360.0f;
+                a[i] = std::cos(hue * float_Pi / 180.0f) * chroma;
+                b[i] = std::sin(hue * float_Pi / 180.0f) * chroma;
+            }
+
+            return;
+        }
+
+        // the sines and cosines are calculated into local arrays first, so that both loops can be
+        // vectorised (see RGBtoCIELab)
+        const float* sinTable = CIELCHConversionTables::getSinTable();
+        const int blockSize = 256;
+        float sinHue[blockSize], cosHue[blockSize];
+
+        for (int start = 0; start < numValues; start += blockSize)
+        {
+            const int num = jmin(blockSize, numValues - start);
+
+            if (precision == CIELCHPrecision::fast)
+            {
+                CIELCHFastMath::sinCosTurns(H + start, sinHue, cosHue, num);
+            }
+            else
+            {
+                for (int i = 0; i < num; ++i)
+                {
+                    // H - std::floor(H), without the std::floor call that would stop the vectoriser:
+                    // the conversion to int rounds towards zero, so negative values need one more turn
+                    const float x = H[start + i] - (float) (int) H[start + i];
+                    const float turns = x + (float) (int) (x < 0.0f);
+                    const float quarter = turns + 0.25f;
+                    sinHue[i] = CIELCHConversionTables::lookup(sinTable, turns);
+                    cosHue[i] = CIELCHConversionTables::lookup(sinTable, quarter - (float) (int) quarter);
+                }
+            }
+
+            for (int i = start; i < start + num; ++i)
+            {
+                // clipping after the multiplication keeps the multiplication out of the
+                // branches of jlimit, where the vectoriser can't speculate it
+                const float chroma = jlimit(0.0f, 134.0f, C[i] * 134.0f);
+                a[i] = cosHue[i - start] * chroma;
+                b[i] = sinHue[i - start] * chroma;
+            }
+        }
+    }
+
+    //==============================================================================
+    /** Convert a line of pixels from sRGB to CIE LCH. @see CIELCHColour::RGBtoCIELCH */
+    static void RGBtoCIELCH(const PixelARGB* pixels, float* L, float* C, float* H, int numPixels) noexcept
+    {
+        // the a and b values are stored in C and H, and converted in place
+        RGBtoCIELab(pixels, L, C, H, numPixels);
+        CIELabtoCIELCH(C, H, C, H, numPixels);
+
+        for (int i = 0; i < numPixels; ++i)
+            L[i] = L[i] / 100.0f;
+    }
+
+    /** Convert a line of CIE LCH values to sRGB. The alpha of the pixels is left untouched.
+    If imaginary isn't null, it receives numPixels flags of the colours which had to be clipped.
+    @returns the number of imaginary colours, which had to be clipped.
+    @see CIELCHColour::CIELCHtoRGB
+    */
+    static int CIELCHtoRGB(const float* L, const float* C, const float* H, PixelARGB* pixels, int numPixels,
+                           bool* imaginary = nullptr) noexcept
+    {
+        int numImaginary = 0;
+        const int blockSize = 256;
+        float labL[blockSize], a[blockSize], b[blockSize];
+
+        for (int start = 0; start < numPixels; start += blockSize)
+        {
+            const int num = jmin(blockSize, numPixels - start);
+
+            for (int i = 0; i < num; ++i)
+                labL[i] = jlimit(0.0f, 100.0f, L[start + i] * 100.0f);
+
+            CIELCHtoCIELab(C + start, H + start, a, b, num);
+            numImaginary += CIELabtoRGB(labL, a, b, pixels + start, num,
+                                        imaginary != nullptr ? imaginary + start : nullptr);
+        }
+
+        return numImaginary;
+    }
+
+    /** Convert a single colour from sRGB to CIE LCH. All values are in the range 0...1 */
+    static void RGBtoCIELCH(PixelARGB pixel, float& L, float& C, float& H) noexcept
+    {
+        RGBtoCIELCH(&pixel, &L, &C, &H, 1);
+    }
+
+    /** Convert a single colour from CIE LCH to sRGB. The alpha of the pixel is left untouched.
+    @returns true if the colour is imaginary and had to be clipped.
+    */
+    static bool CIELCHtoRGB(float L, float C, float H, PixelARGB& pixel) noexcept
+    {
+        return CIELCHtoRGB(&L, &C, &H, &pixel, 1) != 0;
+    }
+
+private:
+
+    //==============================================================================
+    static float gammaCorrection(float g) noexcept
+    {
+        if (g > 0.0031308f)
+            return 1.055f * std::pow(g, (1.0f / 2.4f)) - 0.055f;
+        else
+            return 12.92f * g;
+    }
+
+    /** Rounds a value in the range 0...1 to 0...255 */
+    static uint8 toUint8(float x) noexcept
+    {
+        if (precision == CIELCHPrecision::exact)
+            return (uint8) std::round(x * 255.0f);
+
+        return (uint8) (x * 255.0f + 0.5f);
+    }
+
+    static float f(float t, const float* cubeRoot) noexcept
+    {
+        if (precision == CIELCHPrecision::exact)
+        {
+            if (t <= 0.008856f)
+                return (7.787f * t) + (16.0f / 116.0f);
+
+            return std::pow(t, (1.0f / 3.0f));
+        }
+
+        float y;
+
+        if (precision == CIELCHPrecision::fastest)
+        {
+            // t can be slightly above 1 for white, where the table is extrapolated
+            y = CIELCHConversionTables::lookup(cubeRoot, t);
+        }
+        else
+        {
+            // a bit trick for the first guess, refined with Newton iterations
+            uint32 bits;
+            std::memcpy(&bits, &t, sizeof(bits));
+            bits = bits / 3 + 0x2a514067;
+            std::memcpy(&y, &bits, sizeof(y));
+
+            for (int i = 0; i < 3; ++i)
+                y = (2.0f * y + t / (y * y)) * (1.0f / 3.0f);
+        }
+
+        return CIELCHFastMath::select(t > 0.008856f, y, (7.787f * t) + (16.0f / 116.0f));
+    }
+
+    static float fInverse(float t) noexcept
+    {
+        if (precision == CIELCHPrecision::exact)
+        {
+            if (t > 6.0f / 29.0f)
+                return std::pow(t, 3.0f);
+
+            return (t - 16.0f / 116.0f) / 7.787f;
+        }
+
+        return CIELCHFastMath::select(t > 6.0f / 29.0f, t * t * t, (t - 16.0f / 116.0f) / 7.787f);
+    }
+
+    /** Returns the hue of (a, b) in the range 0...1 */
+    static float hueOf(float a, float b, const float* arcTan) noexcept
+    {
+        if (precision == CIELCHPrecision::exact)
+        {
+            //the same as CIELCHColour::CIELabtoCIELCH
+            float H = std::atan2(b, a);
+
+            if (H > 0)
+                H = (H / float_Pi) * 180.0f;
+            else
+                H = 360.0f - (std::abs(H) / float_Pi) * 180.0f;
+
+            return H / 360.0f;
+        }
+
+        // reduce to the first octant, where 0 <= t <= 1, and move the result back to the right
+        // quadrant without branches (see CIELCHFastMath::atan2Turns)
+        const float absA = std::abs(a);
+        const float absB = std::abs(b);
+        const float t = jmin(absA, absB) / jmax(absA, absB, 1.0e-30f);
+
+        float turns = CIELCHConversionTables::lookup(arcTan, t);
+        turns = CIELCHFastMath::select(absB > absA, 0.25f - turns, turns);
+        turns = CIELCHFastMath::select(a < 0.0f,    0.5f  - turns, turns);
+        turns = CIELCHFastMath::select(b < 0.0f,    1.0f  - turns, turns);
+        return turns;
+    }
+};
+
+//==============================================================================
+/**
+The run-time selectable variant of CIELCHConversion.
+
+The functions of the CIELCHConversion instantiation for the chosen precision are bound when
+the converter is created, compiled for the best instruction set of the CPU (see CIELCHKernels).
+Calling them costs one indirect call per line.
+
+Here an example on how to use the class:
+@code
+CIELCHConverter converter(isExporting ? CIELCHPrecision::exact : CIELCHPrecision::fastest);
+converter.RGBtoCIELCH(pixels, L, C, H, numPixels);
+@endcode
+*/
+class CIELCHConverter
+{
+public:
+
+    /** Creates a converter with the given precision, by default the one of getDefaultPrecision(). */
+    explicit CIELCHConverter(CIELCHPrecision precision = getDefaultPrecision()) noexcept;
+
+    /** Returns the precision of this converter. */
+    CIELCHPrecision getPrecision() const noexcept    { return precision; }
+
+    //==============================================================================
+    /** Sets the precision which the CIELCHColour functions, the image operations and new
+    converters use when they are called without one. It starts as CIELCH_DEFAULT_PRECISION.
+    This can be called from any thread, but calls which are already running keep the
+    precision they started with.
+    */
+    static void setDefaultPrecision(CIELCHPrecision newPrecision) noexcept;
+
+    /** Returns the precision set with setDefaultPrecision(). */
+    static CIELCHPrecision getDefaultPrecision() noexcept;
+
+    //==============================================================================
+
+    /** @see CIELCHConversion::RGBtoCIELab */
+    void RGBtoCIELab(const PixelARGB* pixels, float* L, float* a, float* b, int numPixels) const noexcept
+    {
+        rgbToLab(pixels, L, a, b, numPixels);
+    }
+
+    /** @see CIELCHConversion::CIELabtoRGB */
+    int CIELabtoRGB(const float* L, const float* a, const float* b, PixelARGB* pixels, int numPixels) const noexcept
+    {
+        return labToRgb(L, a, b, pixels, numPixels);
+    }
+
+    /** @see CIELCHConversion::CIELabtoCIELCH */
+    void CIELabtoCIELCH(const float* a, const float* b, float* C, float* H, int numValues) const noexcept
+    {
+        labToLch(a, b, C, H, numValues);
+    }
+
+    /** @see CIELCHConversion::CIELCHtoCIELab */
+    void CIELCHtoCIELab(const float* C, const float* H, float* a, float* b, int numValues) const noexcept
+    {
+        lchToLab(C, H, a, b, numValues);
+    }
+
+    /** @see CIELCHConversion::RGBtoCIELCH */
+    void RGBtoCIELCH(const PixelARGB* pixels, float* L, float* C, float* H, int numPixels) const noexcept
+    {
+        rgbToLch(pixels, L, C, H, numPixels);
+    }
+
+    /** @see CIELCHConversion::CIELCHtoRGB */
+    int CIELCHtoRGB(const float* L, const float* C, const float* H, PixelARGB* pixels, int numPixels) const noexcept
+    {
+        return lchToRgb(L, C, H, pixels, numPixels);
+    }
+
+private:
+
+    CIELCHPrecision precision;
+
+    void (*rgbToLab)(const PixelARGB*, float*, float*, float*, int) noexcept;
+    int  (*labToRgb)(const float*, const float*, const float*, PixelARGB*, int) noexcept;
+    void (*labToLch)(const float*, const float*, float*, float*, int) noexcept;
+    void (*lchToLab)(const float*, const float*, float*, float*, int) noexcept;
+    void (*rgbToLch)(const PixelARGB*, float*, float*, float*, int) noexcept;
+    int  (*lchToRgb)(const float*, const float*, const float*, PixelARGB*, int) noexcept;
+};
+
+
+#endif  // CIELCHConversion_H_INCLUDED
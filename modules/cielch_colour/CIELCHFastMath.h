@@ -0,0 +1,176 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+#ifndef CIELCHFastMath_H_INCLUDED
+#define CIELCHFastMath_H_INCLUDED
+
+//==============================================================================
+/**
+Fast approximations of atan2, sin, cos and hypot for the conversion between CIE Lab and CIE LCH.
+
+All angles are in turns, i.e. in the same 0...1 range as the CIE hue of the CIELCHColour class.
+The conversions between radians, degrees and turns are folded into the polynomial coefficients,
+so there is no extra scaling.
+
+The functions contain no branches and no library calls, so loops over arrays of values (like the
+array versions below) can be auto-vectorised by the compiler. They don't depend on IEEE rounding
+tricks either, so they give the same results with -ffast-math (Projucer: "Relax IEEE compliance").
+
+The polynomials are minimax fits. The error bounds below are the measured maximum errors of the
+float implementation, tested against double precision std::atan2, std::sin and std::cos over all
+float values between -1 and 1 (sinTurns, cosTurns) and over 16 million (x, y) pairs on a dense polar
+grid (atan2Turns):
+- atan2Turns: |error| <= 1.0e-7 turns (3.6e-5 degrees)
+- sinTurns: |error| <= 2.1e-7
+- cosTurns: |error| <= 4.0e-7
+- hypot: relative error <= 2.3e-7, tested on a grid of 16 million (x, y) pairs between -200 and 200
+Larger arguments of sinTurns and cosTurns add the rounding error of the argument itself.
+
+Even at the largest CIE chroma this is a colour difference of less than 0.0001 Delta E.
+*/
+struct CIELCHFastMath
+{
+    /** Returns the angle of the vector (x, y) in turns, in the range 0...1.
+    The result is the same as std::atan2(y, x) / (2 pi), plus one turn when negative.
+    atan2Turns(0, 0) is 0.
+    */
+    static forcedinline float atan2Turns(float y, float x) noexcept
+    {
+        const float absX = std::abs(x);
+        const float absY = std::abs(y);
+
+        // atan(t) / (2 pi) for 0 <= t <= 1, |error| <= 4e-8 turns
+        const float t = jmin(absX, absY) / jmax(absX, absY, 1.0e-30f);
+        const float t2 = t * t;
+        float r = t * (0.15915432f + t2 * (-0.053026238f + t2 * (0.031525118f + t2 * (-0.021061518f
+                     + t2 * (0.012672501f + t2 * (-0.0053482778f + t2 * 0.0010841306f))))));
+
+        // move from the first octant to the right quadrant
+        r = select(absY > absX, 0.25f - r, r);
+        r = select(x < 0.0f,    0.5f  - r, r);
+        r = select(y < 0.0f,    1.0f  - r, r);
+        return r;
+    }
+
+    /** Returns sin(2 pi x), i.e. the sine of an angle in turns.
+    x can be any value with |x| < 2^22.
+    */
+    static forcedinline float sinTurns(float x) noexcept
+    {
+        // reduce to -0.5...0.5 by subtracting the nearest integer. The conversion to int rounds
+        // towards zero, so adding 0.5 with the sign of x rounds to the nearest integer, without
+        // the std::round call that would stop the vectoriser.
+        x -= (float) (int) (x + std::copysign(0.5f, x));
+
+        // fold onto -0.25...0.25: sin(2 pi x) = sin(2 pi (0.5 - x))
+        const float absX = std::abs(x);
+        x = std::copysign(jmin(absX, 0.5f - absX), x);
+
+        // sin(2 pi x) for |x| <= 0.25, |error| <= 3.4e-9
+        const float x2 = x * x;
+        return x * (6.2831852f + x2 * (-41.341655f + x2 * (81.601004f + x2 * (-76.549782f + x2 * 39.536706f))));
+    }
+
+    /** Returns cos(2 pi x), i.e. the cosine of an angle in turns.
+    x can be any value with |x| < 2^22.
+    */
+    static forcedinline float cosTurns(float x) noexcept
+    {
+        return sinTurns(x + 0.25f);
+    }
+
+    /** Returns sqrt(x * x + y * y), for |x| and |y| below 1e18.
+    std::sqrt might set errno, which stops GCC from vectorising it unless -fno-math-errno is used.
+    This uses a bit trick for the reciprocal square root instead, refined with Newton iterations.
+    */
+    static forcedinline float hypot(float x, float y) noexcept
+    {
+        // the tiny offset avoids the division by zero for (0, 0) without a branch
+        const float squared = x * x + y * y;
+        const float t = squared + 1.0e-30f;
+
+        uint32 bits;
+        std::memcpy(&bits, &t, sizeof(bits));
+        bits = 0x5f375a86 - (bits >> 1);
+        float r;
+        std::memcpy(&r, &bits, sizeof(r));
+
+        for (int i = 0; i < 3; ++i)
+            r = r * (1.5f - 0.5f * t * r * r);
+
+        // squared is 0 for (0, 0), so the result is exactly 0
+        return squared * r;
+    }
+
+    /** Returns condition ? ifTrue : ifFalse, without a branch.
+    A conditional expression stops the vectoriser, unless -ffast-math allows the compiler to
+    calculate both values. Multiplying the condition in as 0 or 1 would give NaN for an infinite
+    value, and -ffast-math may rearrange it. So the bits of the values are masked instead.
+    */
+    static forcedinline float select(bool condition, float ifTrue, float ifFalse) noexcept
+    {
+        uint32 trueBits, falseBits;
+        std::memcpy(&trueBits, &ifTrue, sizeof(trueBits));
+        std::memcpy(&falseBits, &ifFalse, sizeof(falseBits));
+
+        const uint32 mask = 0u - (uint32) condition;
+        const uint32 bits = (trueBits & mask) | (falseBits & ~mask);
+
+        float result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    //==============================================================================
+    /** Calculates atan2Turns(y[i], x[i]) for numValues values. */
+    static void atan2Turns(const float* y, const float* x, float* result, int numValues) noexcept
+    {
+        for (int i = 0; i < numValues; ++i)
+            result[i] = atan2Turns(y[i], x[i]);
+    }
+
+    /** Calculates sinTurns(x[i]) and cosTurns(x[i]) for numValues values. */
+    static void sinCosTurns(const float* x, float* sinResult, float* cosResult, int numValues) noexcept
+    {
+        for (int i = 0; i < numValues; ++i)
+        {
+            const float turns = x[i];
+            sinResult[i] = sinTurns(turns);
+            cosResult[i] = cosTurns(turns);
+        }
+    }
+};
+
+
+#endif  // CIELCHFastMath_H_INCLUDED
@@ -0,0 +1,204 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+namespace
+{
+    /** Lines start at multiples of this many bytes (a cache line, and an AVX-512 register) */
+    const size_t alignment = 64;
+}
+
+CIELCHImageBuffer::CIELCHImageBuffer(int w, int h)
+    : width(jmax(0, w)), height(jmax(0, h))
+{
+    allocate();
+}
+
+CIELCHImageBuffer::CIELCHImageBuffer(const Image& image, CIELCHPrecision precision)
+    : width(image.getWidth()), height(image.getHeight())
+{
+    allocate();
+
+    if (!image.isValid())
+        return;
+
+    const Image::BitmapData data(image, Image::BitmapData::readOnly);
+    const CIELCHConverter converter(precision);
+
+    CIELCHParallel::forEachRowRange(width, height, [&](int startRow, int endRow, int)
+    {
+        HeapBlock<PixelARGB> pixels((size_t) width);
+
+        for (int y = startRow; y < endRow; ++y)
+        {
+            CIELCHImageLine::read(data, y, pixels);
+            converter.RGBtoCIELCH(pixels, getL(y), getC(y), getH(y), width);
+
+            float* alpha = getAlpha(y);
+
+            for (int x = 0; x < width; ++x)
+                alpha[x] = (float) pixels[x].getAlpha() * (1.0f / 255.0f);
+        }
+    });
+}
+
+void CIELCHImageBuffer::allocate()
+{
+    const size_t floatsPerAlignment = alignment / sizeof(float);
+    lineStride = (int) (((size_t) width + floatsPerAlignment - 1) / floatsPerAlignment * floatsPerAlignment);
+
+    // 4 planes, plus room to move the start to the next aligned address
+    storage.calloc((size_t) lineStride * (size_t) height * 4 + floatsPerAlignment);
+
+    const size_t address = (size_t) storage.getData();
+    planes = storage.getData() + ((alignment - address % alignment) % alignment) / sizeof(float);
+}
+
+//==============================================================================
+int64 CIELCHImageBuffer::writeTo(Image& image, CIELCHPrecision precision) const
+{
+    // the image must have the same size as the buffer
+    jassert(image.getWidth() == width && image.getHeight() == height);
+
+    if (!image.isValid() || image.getWidth() != width || image.getHeight() != height)
+        return 0;
+
+    const Image::BitmapData data(image, Image::BitmapData::writeOnly);
+    const CIELCHConverter converter(precision);
+    std::atomic<int64> numImaginary(0);
+
+    CIELCHParallel::forEachRowRange(width, height, [&](int startRow, int endRow, int)
+    {
+        HeapBlock<PixelARGB> pixels((size_t) width);
+        int64 imaginary = 0;
+
+        for (int y = startRow; y < endRow; ++y)
+        {
+            const float* alpha = getAlpha(y);
+
+            // the alpha is rounded here, the colours are left untouched by CIELCHtoRGB
+            for (int x = 0; x < width; ++x)
+                pixels[x] = PixelARGB((uint8) roundToInt(jlimit(0.0f, 1.0f, alpha[x]) * 255.0f), 0, 0, 0);
+
+            imaginary += converter.CIELCHtoRGB(getL(y), getC(y), getH(y), pixels, width);
+            CIELCHImageLine::write(data, y, pixels);
+        }
+
+        numImaginary += imaginary;
+    });
+
+    return numImaginary;
+}
+
+Image CIELCHImageBuffer::toImage(Image::PixelFormat format, CIELCHPrecision precision) const
+{
+    if (width == 0 || height == 0)
+        return Image();
+
+    Image image(format, width, height, false);
+    writeTo(image, precision);
+    return image;
+}
+
+//==============================================================================
+void CIELCHImageBuffer::applyTransform(const CIELabPlaneTransform& transform)
+{
+    CIELCHParallel::forEachRowRange(width, height, [&](int startRow, int endRow, int)
+    {
+        HeapBlock<float> a((size_t) width), b((size_t) width);
+
+        for (int y = startRow; y < endRow; ++y)
+        {
+            float* C = getC(y);
+            float* H = getH(y);
+
+            // the transform works in the a-b plane, with the chroma in the range 0...134
+            CIELCHConversion<CIELCHPrecision::exact>::CIELCHtoCIELab(C, H, a, b, width);
+            transform.transformPoints(a, b, width);
+            CIELCHConversion<CIELCHPrecision::exact>::CIELabtoCIELCH(a, b, C, H, width);
+        }
+    });
+}
+
+void CIELCHImageBuffer::applyToneCurve(const CIELCHToneCurve& curve, const CIELCHToneCurve* chromaCurve)
+{
+    CIELCHParallel::forEachRowRange(width, height, [&](int startRow, int endRow, int)
+    {
+        for (int y = startRow; y < endRow; ++y)
+        {
+            float* L = getL(y);
+            float* C = getC(y);
+
+            for (int x = 0; x < width; ++x)
+                L[x] = jlimit(0.0f, 1.0f, curve.getValue(L[x]));
+
+            // changing the chroma in LCH keeps the hue, like scaling a and b does
+            if (chromaCurve != nullptr)
+                for (int x = 0; x < width; ++x)
+                    C[x] *= jmax(0.0f, chromaCurve->getValue(L[x]));
+        }
+    });
+}
+
+void CIELCHImageBuffer::blend(const CIELCHImageBuffer& other, float amount, CIELCHBlendMode mode)
+{
+    // the buffers must have the same size
+    jassert(other.width == width && other.height == height);
+
+    if (other.width != width || other.height != height)
+        return;
+
+    amount = jlimit(0.0f, 1.0f, amount);
+
+    CIELCHParallel::forEachRowRange(width, height, [&](int startRow, int endRow, int)
+    {
+        HeapBlock<float> colourWeights((size_t) width);
+
+        for (int y = startRow; y < endRow; ++y)
+        {
+            float* alpha = getAlpha(y);
+            const float* otherAlpha = other.getAlpha(y);
+
+            // like CIELCHBlend: the alpha is blended linearly, and each colour is weighted by its alpha
+            for (int x = 0; x < width; ++x)
+            {
+                const float newAlpha = alpha[x] + amount * (otherAlpha[x] - alpha[x]);
+                colourWeights[x] = newAlpha > 0.0f ? jmin(1.0f, amount * otherAlpha[x] / newAlpha) : 0.0f;
+                alpha[x] = newAlpha;
+            }
+
+            CIELCHBlend::blendCIELCH(getL(y), getC(y), getH(y), other.getL(y), other.getC(y), other.getH(y),
+                                     colourWeights, width, mode);
+        }
+    });
+}
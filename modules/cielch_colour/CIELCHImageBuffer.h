@@ -0,0 +1,144 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+#ifndef CIELCHImageBuffer_H_INCLUDED
+#define CIELCHImageBuffer_H_INCLUDED
+
+class CIELabPlaneTransform;
+class CIELCHToneCurve;
+
+//==============================================================================
+/**
+An image stored as float CIE LCH values, for chains of operations without 8-bit rounding.
+
+Every operation on a juce::Image converts the pixels to CIE LCH and back, and rounds them to
+8 bits each time. This buffer converts an image once, lets several operations work on the float
+values, and rounds only once, when the result is written back to an Image. Because the
+conversions are skipped, each operation in the chain is also faster than its Image version.
+Colours which an operation moves outside the sRGB gamut are kept as they are, and only clipped
+when they are written back. So a chain can bring them back into the gamut without losing
+anything, where the Image versions would clip them after every operation.
+
+The lightness, chroma, hue and alpha are stored in separate planes, all values in the range 0...1
+like in CIELCHColour. The alpha is not premultiplied. Every line of every plane starts at a
+64-byte boundary, so the line conversions and operations work on aligned, contiguous floats.
+There is no half-float variant: the operations would have to convert every line to float and
+back, which costs about as much as the 8-bit conversions the buffer avoids.
+
+Here an example on how to use the class:
+@code
+CIELCHImageBuffer buffer(img);
+buffer.applyTransform(CIELabPlaneTransform::hueRotation(0.2f));
+buffer.applyToneCurve(CIELCHToneCurve::contrast(0.4f));
+buffer.blend(overlayBuffer, 0.5f);
+buffer.writeTo(img);
+@endcode
+*/
+class CIELCHImageBuffer
+{
+public:
+
+    /** Creates a buffer of the given size, with all pixels transparent black. */
+    CIELCHImageBuffer(int width, int height);
+
+    /** Creates a buffer with the pixels of an image.
+    @param image = the image to convert. All pixel formats are supported.
+    @param precision = the precision of the colour conversion, see CIELCHPrecision. By default
+                       the one of CIELCHConverter::getDefaultPrecision().
+    */
+    explicit CIELCHImageBuffer(const Image& image,
+                               CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision());
+
+    //==============================================================================
+    /** Writes the pixels to an image of the same size, rounding them to 8 bits.
+    @returns the number of imaginary colours, which had to be clipped.
+    */
+    int64 writeTo(Image& image,
+                  CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision()) const;
+
+    /** Returns a new image with the pixels of the buffer. */
+    Image toImage(Image::PixelFormat format = Image::ARGB,
+                  CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision()) const;
+
+    //==============================================================================
+    /** Applies a hue rotation and/or chroma multiplication to all pixels. */
+    void applyTransform(const CIELabPlaneTransform& transform);
+
+    /** Applies a lightness curve and optionally a chroma curve to all pixels.
+    @see CIELCHToneCurve::applyTo
+    */
+    void applyToneCurve(const CIELCHToneCurve& curve, const CIELCHToneCurve* chromaCurve = nullptr);
+
+    /** Blends another buffer of the same size into this one, like CIELCHBlend::blend. */
+    void blend(const CIELCHImageBuffer& other, float amount, CIELCHBlendMode mode = CIELCHBlendMode::all);
+
+    //==============================================================================
+    int getWidth() const noexcept                   { return width; }
+    int getHeight() const noexcept                  { return height; }
+
+    /** Returns the distance in floats from one line of a plane to the next. */
+    int getLineStride() const noexcept              { return lineStride; }
+
+    /** Returns a pointer to line y of the lightness plane. */
+    float* getL(int y) noexcept                     { return getPlane(0, y); }
+    const float* getL(int y) const noexcept         { return getPlane(0, y); }
+    /** Returns a pointer to line y of the chroma plane. */
+    float* getC(int y) noexcept                     { return getPlane(1, y); }
+    const float* getC(int y) const noexcept         { return getPlane(1, y); }
+    /** Returns a pointer to line y of the hue plane. */
+    float* getH(int y) noexcept                     { return getPlane(2, y); }
+    const float* getH(int y) const noexcept         { return getPlane(2, y); }
+    /** Returns a pointer to line y of the (non premultiplied) alpha plane. */
+    float* getAlpha(int y) noexcept                 { return getPlane(3, y); }
+    const float* getAlpha(int y) const noexcept     { return getPlane(3, y); }
+
+private:
+
+    float* getPlane(int plane, int y) const noexcept
+    {
+        jassert(isPositiveAndBelow(y, height));
+        return planes + ((size_t) plane * (size_t) height + (size_t) y) * (size_t) lineStride;
+    }
+
+    void allocate();
+
+    int width, height, lineStride = 0;
+    HeapBlock<float> storage;
+    float* planes = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CIELCHImageBuffer)
+};
+
+
+#endif  // CIELCHImageBuffer_H_INCLUDED
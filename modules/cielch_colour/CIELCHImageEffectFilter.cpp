@@ -0,0 +1,132 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+CIELCHImageEffectFilter::CIELCHImageEffectFilter(float lightness, float chroma, float hue, CIELCHPrecision precision)
+    : converter(precision)
+{
+    setOperation(lightness, chroma, hue);
+}
+
+void CIELCHImageEffectFilter::setOperation(float lightness, float chroma, float hue)
+{
+    lightnessMultiplier = jmax(0.0f, lightness);
+    chromaMultiplier = chroma;
+    hueRotation = hue;
+    transform = CIELabPlaneTransform::chromaMultiplication(chroma).followedBy(CIELabPlaneTransform::hueRotation(hue));
+
+    lastInput = Image();
+}
+
+//==============================================================================
+void CIELCHImageEffectFilter::applyEffect(Image& sourceImage, Graphics& destContext, float /*scaleFactor*/, float alpha)
+{
+    if (isLastInput(sourceImage))
+    {
+        ++numCachedPaints;
+    }
+    else
+    {
+        convert(sourceImage);
+        ++numConversions;
+    }
+
+    destContext.setOpacity(alpha);
+    destContext.drawImageAt(output, 0, 0);
+}
+
+bool CIELCHImageEffectFilter::isLastInput(const Image& image) const
+{
+    if (!lastInput.isValid() || image.getFormat() != lastInput.getFormat()
+        || image.getWidth() != lastInput.getWidth() || image.getHeight() != lastInput.getHeight())
+        return false;
+
+    const Image::BitmapData data(image, Image::BitmapData::readOnly);
+    const Image::BitmapData last(lastInput, Image::BitmapData::readOnly);
+    const size_t numBytes = (size_t) (data.width * data.pixelStride);
+
+    // a changed component usually differs in the first rows already
+    for (int y = 0; y < data.height; ++y)
+        if (std::memcmp(data.getLinePointer(y), last.getLinePointer(y), numBytes) != 0)
+            return false;
+
+    return true;
+}
+
+void CIELCHImageEffectFilter::convert(const Image& image)
+{
+    if (!image.isValid() || image.getFormat() == Image::SingleChannel)
+    {
+        lastInput = Image();
+        output = image;
+        return;
+    }
+
+    if (!lastInput.isValid() || image.getFormat() != lastInput.getFormat()
+        || image.getWidth() != lastInput.getWidth() || image.getHeight() != lastInput.getHeight())
+    {
+        lastInput = Image(image.getFormat(), image.getWidth(), image.getHeight(), false, SoftwareImageType());
+        output = Image(image.getFormat(), image.getWidth(), image.getHeight(), false, SoftwareImageType());
+    }
+
+    {
+        const Image::BitmapData data(image, Image::BitmapData::readOnly);
+        const Image::BitmapData last(lastInput, Image::BitmapData::writeOnly);
+        const Image::BitmapData dest(output, Image::BitmapData::writeOnly);
+        const size_t numBytes = (size_t) (data.width * data.pixelStride);
+
+        CIELCHParallel::forEachRowRange(data.width, data.height, [&](int startRow, int endRow, int)
+        {
+            for (int y = startRow; y < endRow; ++y)
+            {
+                std::memcpy(last.getLinePointer(y), data.getLinePointer(y), numBytes);
+                std::memcpy(dest.getLinePointer(y), data.getLinePointer(y), numBytes);
+            }
+        });
+    }
+
+    const float lightness = lightnessMultiplier;
+
+    CIELCHUniqueColours::applyTo(output, [&](PixelARGB* pixels, int num)
+    {
+        HeapBlock<float> L((size_t) num), a((size_t) num), b((size_t) num);
+
+        converter.RGBtoCIELab(pixels, L, a, b, num);
+
+        for (int i = 0; i < num; ++i)
+            L[i] = jmin(100.0f, L[i] * lightness);
+
+        transform.transformPoints(a, b, num);
+        converter.CIELabtoRGB(L, a, b, pixels, num);
+    });
+}
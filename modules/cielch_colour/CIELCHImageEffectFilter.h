@@ -0,0 +1,102 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+#ifndef CIELCHImageEffectFilter_H_INCLUDED
+#define CIELCHImageEffectFilter_H_INCLUDED
+
+//==============================================================================
+/**
+An ImageEffectFilter which changes the CIE lightness, chroma and hue of a whole Component, e.g. to
+dim and desaturate disabled panels or inactive windows.
+
+The three changes are fused into one conversion of every pixel: the lightness is multiplied, and a
+single CIELabPlaneTransform multiplies the chroma and rotates the hue. The rows of the component's
+image are read and written through Image::BitmapData on all CPU cores, and components with few
+distinct colours convert each colour only once (see CIELCHUniqueColours).
+
+The filter keeps a copy of the last image it received and its result. As long as the component
+paints the same image again, the result is drawn without any conversion. The component itself is
+still painted into the effect image on every repaint, as for every ImageEffectFilter.
+
+This class is only available if the juce_gui_basics module is used.
+
+Here an example on how to use the class:
+@code
+CIELCHImageEffectFilter disabledEffect(0.8f, 0.2f);
+panel.setComponentEffect(panel.isEnabled() ? nullptr : &disabledEffect);
+@endcode
+*/
+class CIELCHImageEffectFilter  : public ImageEffectFilter
+{
+public:
+
+    /** Creates the filter.
+    @param lightnessMultiplier = multiplies the CIE lightness, values below 1 dim the component
+    @param chromaMultiplier = multiplies the CIE chroma, 0 makes the component grey
+    @param hueRotation = rotates the CIE hue, in the range 0...1 like CIELCHColour::withRotatedCIEHue
+    @param precision = the precision of the colour conversions, see CIELCHPrecision.
+    */
+    explicit CIELCHImageEffectFilter(float lightnessMultiplier = 1.0f, float chromaMultiplier = 1.0f,
+                                     float hueRotation = 0.0f, CIELCHPrecision precision = CIELCHPrecision::fast);
+
+    /** Changes the operation. The next paint converts the component's image again. */
+    void setOperation(float lightnessMultiplier, float chromaMultiplier, float hueRotation);
+
+    float getLightnessMultiplier() const noexcept   { return lightnessMultiplier; }
+    float getChromaMultiplier() const noexcept      { return chromaMultiplier; }
+    float getHueRotation() const noexcept           { return hueRotation; }
+
+    /** Returns the number of paints which reused the cached result, and the number of conversions. */
+    int64 getNumCachedPaints() const noexcept       { return numCachedPaints; }
+    int64 getNumConversions() const noexcept        { return numConversions; }
+
+    /** @internal */
+    void applyEffect(Image& sourceImage, Graphics& destContext, float scaleFactor, float alpha) override;
+
+private:
+
+    bool isLastInput(const Image& image) const;
+    void convert(const Image& image);
+
+    float lightnessMultiplier, chromaMultiplier, hueRotation;
+    CIELabPlaneTransform transform;
+    const CIELCHConverter converter;
+
+    Image lastInput, output;
+    int64 numCachedPaints = 0, numConversions = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CIELCHImageEffectFilter)
+};
+
+
+#endif  // CIELCHImageEffectFilter_H_INCLUDED
@@ -0,0 +1,209 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+//==============================================================================
+struct CIELCHImageJob::Worker  : public ThreadPoolJob
+{
+    explicit Worker(std::shared_ptr<CIELCHImageJob> jobToRun)
+        : ThreadPoolJob("CIELCH image job"), job(std::move(jobToRun))
+    {
+    }
+
+    // the pool deletes a worker when it has finished, or when it is removed before running,
+    // so the last worker to go away always completes the job
+    ~Worker()
+    {
+        if (--job->activeWorkers == 0)
+            CIELCHImageJob::finish(job);
+    }
+
+    JobStatus runJob() override
+    {
+        job->processTiles([this] { return shouldExit(); });
+        return jobHasFinished;
+    }
+
+    const std::shared_ptr<CIELCHImageJob> job;
+};
+
+//==============================================================================
+CIELCHImageJob::CIELCHImageJob(const Image& sourceImage, std::function<void(PixelARGB*, int)> pixelFunction,
+                               std::function<void(const Image&)> completionCallback, bool onMessageThread, int rowsPerTile)
+    : source(sourceImage),
+      function(std::move(pixelFunction)),
+      onCompletion(std::move(completionCallback)),
+      callOnMessageThread(onMessageThread),
+      tileHeight(jmax(1, rowsPerTile)),
+      numTiles((source.isValid() && ! source.isSingleChannel()) ? (source.getHeight() + tileHeight - 1) / tileHeight : 0),
+      result(promise.get_future().share())
+{
+    destination = numTiles > 0 ? Image(source.getFormat(), source.getWidth(), source.getHeight(), false)
+                               : source;
+}
+
+float CIELCHImageJob::getProgress() const noexcept
+{
+    if (numTiles == 0)
+        return finished ? 1.0f : 0.0f;
+
+    return (float) tilesDone.load() / (float) numTiles;
+}
+
+void CIELCHImageJob::processTiles(const std::function<bool()>& shouldExit)
+{
+    const int width = source.getWidth();
+    const int height = source.getHeight();
+
+    const Image::BitmapData sourceData(source, Image::BitmapData::readOnly);
+    const Image::BitmapData destData(destination, Image::BitmapData::writeOnly);
+    HeapBlock<PixelARGB> pixels((size_t) width);
+
+    for (;;)
+    {
+        if (cancelled || shouldExit())
+            return;
+
+        const int tile = nextTile++;
+
+        if (tile >= numTiles)
+            return;
+
+        const int endRow = jmin(height, (tile + 1) * tileHeight);
+
+        for (int y = tile * tileHeight; y < endRow; ++y)
+        {
+            CIELCHImageLine::read(sourceData, y, pixels);
+            function(pixels, width);
+            CIELCHImageLine::write(destData, y, pixels);
+        }
+
+        ++tilesDone;
+    }
+}
+
+void CIELCHImageJob::finish(const std::shared_ptr<CIELCHImageJob>& job)
+{
+    // workers removed from the pool before running leave tiles behind
+    if (job->tilesDone < job->numTiles)
+        job->cancelled = true;
+
+    const bool wasCancelled = job->cancelled;
+    const bool callNow = ! wasCancelled && job->onCompletion != nullptr && ! job->callOnMessageThread;
+
+    // the callback is posted before the future is ready, so that a message loop which runs
+    // after waiting for the future always finds it
+    if (! wasCancelled && job->onCompletion != nullptr && job->callOnMessageThread)
+    {
+        // the job may be cancelled while the callback waits for the message thread
+        MessageManager::callAsync([job]
+        {
+            if (! job->cancelled)
+                job->onCompletion(job->destination);
+        });
+    }
+
+    job->finished = true;
+    job->promise.set_value(wasCancelled ? Image() : job->destination);
+
+    if (callNow)
+        job->onCompletion(job->destination);
+}
+
+//==============================================================================
+CIELCHImageJobQueue::CIELCHImageJobQueue(int numThreads, int rowsPerTile)
+    : pool(numThreads > 0 ? numThreads : SystemStats::getNumCpus()),
+      numWorkers(numThreads > 0 ? numThreads : SystemStats::getNumCpus()),
+      tileHeight(jmax(1, rowsPerTile))
+{
+}
+
+CIELCHImageJobQueue::~CIELCHImageJobQueue()
+{
+    cancelAll();
+    pool.removeAllJobs(true, -1);
+}
+
+std::shared_ptr<CIELCHImageJob> CIELCHImageJobQueue::submit(const Image& source, PixelFunction function,
+                                                            CompletionCallback onCompletion, bool callOnMessageThread)
+{
+    auto job = std::make_shared<CIELCHImageJob>(source, std::move(function), std::move(onCompletion),
+                                                callOnMessageThread, tileHeight);
+
+    const int numJobWorkers = jmin(numWorkers, job->numTiles);
+
+    if (numJobWorkers == 0)
+    {
+        CIELCHImageJob::finish(job);
+        return job;
+    }
+
+    {
+        const ScopedLock sl(lock);
+
+        jobs.erase(std::remove_if(jobs.begin(), jobs.end(),
+                                  [] (const std::weak_ptr<CIELCHImageJob>& j) { return j.expired(); }),
+                   jobs.end());
+        jobs.push_back(job);
+    }
+
+    job->activeWorkers = numJobWorkers;
+
+    for (int i = 0; i < numJobWorkers; ++i)
+        pool.addJob(new CIELCHImageJob::Worker(job), true);
+
+    return job;
+}
+
+void CIELCHImageJobQueue::cancelAll()
+{
+    const ScopedLock sl(lock);
+
+    for (auto& j : jobs)
+        if (auto job = j.lock())
+            job->cancel();
+}
+
+int CIELCHImageJobQueue::getNumUnfinishedJobs() const
+{
+    const ScopedLock sl(lock);
+
+    int numUnfinished = 0;
+
+    for (auto& j : jobs)
+        if (auto job = j.lock())
+            if (! job->isFinished())
+                ++numUnfinished;
+
+    return numUnfinished;
+}
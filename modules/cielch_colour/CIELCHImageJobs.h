@@ -0,0 +1,173 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+#ifndef CIELCHImageJobs_H_INCLUDED
+#define CIELCHImageJobs_H_INCLUDED
+
+//==============================================================================
+/**
+The handle of an image conversion running in the background, see CIELCHImageJobQueue.
+
+The result is delivered through a std::shared_future, which holds the converted image, or an
+invalid Image if the job was cancelled. The job can be cancelled at any time; the workers check
+for it before every tile, so a cancelled job stops within the time of one tile.
+*/
+class CIELCHImageJob
+{
+public:
+
+    /** Returns the future of the converted image. It is an invalid Image if the job was cancelled. */
+    std::shared_future<Image> getResult() const             { return result; }
+
+    /** Returns the part of the image which has been converted, from 0 to 1. */
+    float getProgress() const noexcept;
+
+    /** Stops the job after the tiles which are being converted, and drops its completion callback,
+    even if the job has already finished and the callback is waiting for the message thread.
+    */
+    void cancel() noexcept                                  { cancelled = true; }
+
+    bool isCancelled() const noexcept                       { return cancelled; }
+
+    /** Returns true once the result is available (or the job was cancelled and has stopped). */
+    bool isFinished() const noexcept                        { return finished; }
+
+    /** @internal use CIELCHImageJobQueue::submit */
+    CIELCHImageJob(const Image& source, std::function<void(PixelARGB*, int)> function,
+                   std::function<void(const Image&)> onCompletion, bool callOnMessageThread, int tileHeight);
+
+private:
+
+    friend class CIELCHImageJobQueue;
+    struct Worker;
+
+    void processTiles(const std::function<bool()>& shouldExit);
+    static void finish(const std::shared_ptr<CIELCHImageJob>& job);
+
+    const Image source;
+    Image destination;
+    const std::function<void(PixelARGB*, int)> function;
+    const std::function<void(const Image&)> onCompletion;
+    const bool callOnMessageThread;
+    const int tileHeight, numTiles;
+
+    std::atomic<int> nextTile { 0 }, tilesDone { 0 }, activeWorkers { 0 };
+    std::atomic<bool> cancelled { false }, finished { false };
+
+    std::promise<Image> promise;
+    std::shared_future<Image> result;
+
+    JUCE_DECLARE_NON_COPYABLE(CIELCHImageJob)
+};
+
+//==============================================================================
+/**
+Runs image conversions in the background, on a pool of worker threads.
+
+A job converts a copy of an image with a pixel function, in tiles of a few rows which are shared
+out to the workers. submit() returns at once with a CIELCHImageJob, which gives the result as a
+future, reports the progress and can be cancelled. Optionally a callback receives the result on the
+message thread, through MessageManager::callAsync, or on the worker thread which finished the job. Cancelled jobs never call their callback.
+
+The pixel function receives non premultiplied pixels, like CIELCHUniqueColours::PixelFunction.
+It is called from several threads at once. The source image is read while the job runs, so it must
+not be changed until the job has finished; the result is a new image.
+
+An editor which starts a new job on every slider movement cancels the previous ones first, so
+stale results are dropped as soon as possible.
+
+Here an example on how to use the class:
+@code
+void MyEditor::sliderValueChanged(Slider*)
+{
+    const CIELabPlaneTransform transform = CIELabPlaneTransform::hueRotation((float) hueSlider.getValue());
+    const CIELCHConverter converter(CIELCHPrecision::fast);
+
+    jobs.cancelAll();
+    currentJob = jobs.submit(original, [transform, converter] (PixelARGB* pixels, int numPixels)
+    {
+        HeapBlock<float> L((size_t) numPixels), a((size_t) numPixels), b((size_t) numPixels);
+        converter.RGBtoCIELab(pixels, L, a, b, numPixels);
+        transform.transformPoints(a, b, numPixels);
+        converter.CIELabtoRGB(L, a, b, pixels, numPixels);
+    },
+    [this] (const Image& result) { preview = result; repaint(); });
+}
+@endcode
+*/
+class CIELCHImageJobQueue
+{
+public:
+
+    typedef std::function<void(PixelARGB* pixels, int numPixels)> PixelFunction;
+    typedef std::function<void(const Image& result)> CompletionCallback;
+
+    /** Creates a queue with its own worker threads.
+    @param numThreads = the number of workers, or 0 for one per CPU core
+    @param tileHeight = the number of rows converted between two checks for cancellation
+    */
+    explicit CIELCHImageJobQueue(int numThreads = 0, int tileHeight = 32);
+
+    /** Cancels all jobs and waits for the workers to stop. */
+    ~CIELCHImageJobQueue();
+
+    /** Starts converting a copy of an image in the background.
+    Invalid and SingleChannel images are returned unchanged.
+    @param source = the image to convert. It must not change until the job has finished.
+    @param function = converts a line of non premultiplied pixels in place
+    @param onCompletion = if not nullptr, called with the result unless the job was cancelled
+    @param callOnMessageThread = calls onCompletion on the message thread, otherwise on a worker thread
+    */
+    std::shared_ptr<CIELCHImageJob> submit(const Image& source, PixelFunction function,
+                                           CompletionCallback onCompletion = nullptr,
+                                           bool callOnMessageThread = true);
+
+    /** Cancels all jobs, including finished jobs whose callbacks have not been called yet. */
+    void cancelAll();
+
+    /** Returns the number of jobs which have not finished yet. */
+    int getNumUnfinishedJobs() const;
+
+private:
+
+    ThreadPool pool;
+    const int numWorkers, tileHeight;
+
+    CriticalSection lock;
+    std::vector<std::weak_ptr<CIELCHImageJob>> jobs;
+
+    JUCE_DECLARE_NON_COPYABLE(CIELCHImageJobQueue)
+};
+
+
+#endif  // CIELCHImageJobs_H_INCLUDED
@@ -0,0 +1,236 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+namespace
+{
+    /** reciprocals[a] = 255 * 2^16 / a, rounded up, and 0 for a = 0.
+    (c * reciprocals[a]) >> 16 is then exactly (c * 255) / a, which PixelARGB::unpremultiply
+    calculates, for every 8-bit c and a, and it can't overflow 32 bits.
+    */
+    const uint32* getReciprocalTable() noexcept
+    {
+        struct Table
+        {
+            Table() noexcept
+            {
+                values[0] = 0;
+
+                for (uint32 a = 1; a < 256; ++a)
+                    values[a] = ((0xffu << 16) + a - 1) / a;
+            }
+
+            uint32 values[256];
+        };
+
+        static const Table table;
+        return table.values;
+    }
+
+    inline PixelARGB unpremultiplied(PixelARGB p, const uint32* reciprocals) noexcept
+    {
+        const uint32 alpha = p.getAlpha();
+
+        if (alpha == 0xff)
+            return p;
+
+        // a transparent pixel has a reciprocal of 0, so it becomes transparent black
+        const uint32 reciprocal = reciprocals[alpha];
+
+        return PixelARGB((uint8) alpha,
+                         (uint8) jmin(0xffu, ((uint32) p.getRed()   * reciprocal) >> 16),
+                         (uint8) jmin(0xffu, ((uint32) p.getGreen() * reciprocal) >> 16),
+                         (uint8) jmin(0xffu, ((uint32) p.getBlue()  * reciprocal) >> 16));
+    }
+
+    inline PixelARGB premultiplied(PixelARGB p) noexcept
+    {
+        if (p.getAlpha() != 0xff)
+            p.premultiply();
+
+        return p;
+    }
+
+    template <class PixelType>
+    void readPixels(const Image::BitmapData& data, int y, PixelARGB* dest) noexcept
+    {
+        const uint32* reciprocals = getReciprocalTable();
+        const uint8* src = data.getLinePointer(y);
+
+        for (int x = 0; x < data.width; ++x)
+        {
+            PixelARGB p;
+            p.set(*reinterpret_cast<const PixelType*>(src));
+            dest[x] = unpremultiplied(p, reciprocals);
+            src += data.pixelStride;
+        }
+    }
+
+    /** ARGB lines without padding between the pixels: runs of opaque pixels are copied in one go */
+    void readPackedARGBPixels(const Image::BitmapData& data, int y, PixelARGB* dest) noexcept
+    {
+        const uint32* reciprocals = getReciprocalTable();
+        const PixelARGB* src = reinterpret_cast<const PixelARGB*>(data.getLinePointer(y));
+        int x = 0;
+
+        while (x < data.width)
+        {
+            const int runStart = x;
+
+            while (x < data.width && src[x].getAlpha() == 0xff)
+                ++x;
+
+            memcpy(dest + runStart, src + runStart, (size_t) (x - runStart) * sizeof(PixelARGB));
+
+            for (; x < data.width && src[x].getAlpha() != 0xff; ++x)
+                dest[x] = unpremultiplied(src[x], reciprocals);
+        }
+    }
+
+    template <class PixelType>
+    void writePixels(const Image::BitmapData& data, int y, const PixelARGB* src) noexcept
+    {
+        uint8* dest = data.getLinePointer(y);
+
+        for (int x = 0; x < data.width; ++x)
+        {
+            reinterpret_cast<PixelType*>(dest)->set(premultiplied(src[x]));
+            dest += data.pixelStride;
+        }
+    }
+
+    template <class PixelType>
+    int readVisiblePixels(const Image::BitmapData& data, int y, PixelARGB* dest, int* positions) noexcept
+    {
+        const uint32* reciprocals = getReciprocalTable();
+        const uint8* src = data.getLinePointer(y);
+        int num = 0;
+
+        for (int x = 0; x < data.width; ++x)
+        {
+            PixelARGB p;
+            p.set(*reinterpret_cast<const PixelType*>(src));
+            src += data.pixelStride;
+
+            if (p.getAlpha() != 0)
+            {
+                if (positions != nullptr)
+                    positions[num] = x;
+
+                dest[num++] = unpremultiplied(p, reciprocals);
+            }
+        }
+
+        return num;
+    }
+
+    template <class PixelType>
+    void writeVisiblePixels(const Image::BitmapData& data, int y, const PixelARGB* src,
+                            const int* positions, int numPixels) noexcept
+    {
+        uint8* line = data.getLinePointer(y);
+
+        for (int i = 0; i < numPixels; ++i)
+            reinterpret_cast<PixelType*>(line + positions[i] * data.pixelStride)->set(premultiplied(src[i]));
+    }
+}
+
+void CIELCHImageLine::read(const Image::BitmapData& data, int y, PixelARGB* dest) noexcept
+{
+    switch (data.pixelFormat)
+    {
+        case Image::ARGB:
+            if (data.pixelStride == (int) sizeof(PixelARGB))
+                readPackedARGBPixels(data, y, dest);
+            else
+                readPixels<PixelARGB>(data, y, dest);
+            break;
+
+        case Image::RGB:            readPixels<PixelRGB>(data, y, dest); break;
+        case Image::SingleChannel:  readPixels<PixelAlpha>(data, y, dest); break;
+        case Image::UnknownFormat:
+        default:                    jassertfalse; break;
+    }
+}
+
+void CIELCHImageLine::write(const Image::BitmapData& data, int y, const PixelARGB* src) noexcept
+{
+    switch (data.pixelFormat)
+    {
+        case Image::ARGB:           writePixels<PixelARGB>(data, y, src); break;
+        case Image::RGB:            writePixels<PixelRGB>(data, y, src); break;
+        case Image::SingleChannel:  writePixels<PixelAlpha>(data, y, src); break;
+        case Image::UnknownFormat:
+        default:                    jassertfalse; break;
+    }
+}
+
+int CIELCHImageLine::readVisible(const Image::BitmapData& data, int y, PixelARGB* dest, int* positions) noexcept
+{
+    switch (data.pixelFormat)
+    {
+        case Image::ARGB:           return readVisiblePixels<PixelARGB>(data, y, dest, positions);
+        case Image::RGB:            return readVisiblePixels<PixelRGB>(data, y, dest, positions);
+        case Image::SingleChannel:  return readVisiblePixels<PixelAlpha>(data, y, dest, positions);
+        case Image::UnknownFormat:
+        default:                    jassertfalse; return 0;
+    }
+}
+
+void CIELCHImageLine::writeVisible(const Image::BitmapData& data, int y, const PixelARGB* src,
+                                   const int* positions, int numPixels) noexcept
+{
+    switch (data.pixelFormat)
+    {
+        case Image::ARGB:           writeVisiblePixels<PixelARGB>(data, y, src, positions, numPixels); break;
+        case Image::RGB:            writeVisiblePixels<PixelRGB>(data, y, src, positions, numPixels); break;
+        case Image::SingleChannel:  writeVisiblePixels<PixelAlpha>(data, y, src, positions, numPixels); break;
+        case Image::UnknownFormat:
+        default:                    jassertfalse; break;
+    }
+}
+
+//==============================================================================
+void CIELCHImageLine::unpremultiply(PixelARGB* pixels, int numPixels) noexcept
+{
+    const uint32* reciprocals = getReciprocalTable();
+
+    for (int i = 0; i < numPixels; ++i)
+        pixels[i] = unpremultiplied(pixels[i], reciprocals);
+}
+
+void CIELCHImageLine::premultiply(PixelARGB* pixels, int numPixels) noexcept
+{
+    for (int i = 0; i < numPixels; ++i)
+        pixels[i] = premultiplied(pixels[i]);
+}
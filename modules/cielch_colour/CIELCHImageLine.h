@@ -0,0 +1,93 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+#ifndef CIELCHImageLine_H_INCLUDED
+#define CIELCHImageLine_H_INCLUDED
+
+//==============================================================================
+/**
+Reads and writes lines of an Image as non premultiplied PixelARGB values.
+
+The CIELCHColour line conversions (e.g. CIELCHColour::RGBtoCIELab) work on non premultiplied
+PixelARGB arrays. These functions move image lines of any pixel format in and out of such arrays.
+
+ARGB images are premultiplied. Instead of dividing by the alpha of every pixel, the pixels are
+unpremultiplied with a table of reciprocals, which gives exactly the same result as
+PixelARGB::unpremultiply. Runs of opaque pixels are copied as they are.
+
+Effects which don't change the alpha (e.g. CIELabPlaneTransform) can use readVisible and
+writeVisible to skip fully transparent pixels, which don't need converting at all. For UI layers
+with lots of transparency this saves most of the work.
+*/
+class CIELCHImageLine
+{
+public:
+
+    /** Copies line y of the bitmap into dest and unpremultiplies the pixels.
+    dest must have space for data.width pixels.
+    */
+    static void read(const Image::BitmapData& data, int y, PixelARGB* dest) noexcept;
+
+    /** Premultiplies the pixels in src and writes them to line y of the bitmap.
+    Fully transparent pixels are written as transparent black.
+    */
+    static void write(const Image::BitmapData& data, int y, const PixelARGB* src) noexcept;
+
+    /** Copies the pixels of line y which aren't fully transparent into dest and unpremultiplies them.
+    dest must have space for data.width pixels. If positions isn't nullptr, the x position of
+    every copied pixel is stored there, for writeVisible.
+    @returns the number of pixels copied
+    */
+    static int readVisible(const Image::BitmapData& data, int y, PixelARGB* dest, int* positions) noexcept;
+
+    /** Premultiplies numPixels pixels read with readVisible and writes them back to their positions.
+    The fully transparent pixels of the line are left untouched.
+    */
+    static void writeVisible(const Image::BitmapData& data, int y, const PixelARGB* src,
+                             const int* positions, int numPixels) noexcept;
+
+    //==============================================================================
+    /** Unpremultiplies numPixels pixels in place. The result is the same as PixelARGB::unpremultiply. */
+    static void unpremultiply(PixelARGB* pixels, int numPixels) noexcept;
+
+    /** Premultiplies numPixels pixels in place. The result is the same as PixelARGB::premultiply. */
+    static void premultiply(PixelARGB* pixels, int numPixels) noexcept;
+
+private:
+
+    CIELCHImageLine() = delete;
+};
+
+
+#endif  // CIELCHImageLine_H_INCLUDED
@@ -0,0 +1,197 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+namespace
+{
+    /** The statistics one worker collects over its band of rows */
+    struct Accumulator
+    {
+        explicit Accumulator(int numBins)
+            : lightness((size_t) numBins, true), chroma((size_t) numBins, true), hue((size_t) numBins, true)
+        {
+        }
+
+        HeapBlock<double> lightness, chroma, hue;
+        double sum[3] = { 0.0, 0.0, 0.0 };
+        double sumOfSquares[3] = { 0.0, 0.0, 0.0 };
+        int64 numPixels = 0;
+        int64 numNeutral = 0;
+    };
+
+    void accumulateLine(Accumulator& acc, int numBins, float neutralChroma,
+                        const float* L, const float* a, const float* b,
+                        const float* C, const float* H, int num) noexcept
+    {
+        const float binScale = (float) numBins;
+        const int lastBin = numBins - 1;
+        double sum[3] = { 0.0, 0.0, 0.0 };
+        double sumOfSquares[3] = { 0.0, 0.0, 0.0 };
+        int64 numNeutral = 0;
+
+        for (int i = 0; i < num; ++i)
+        {
+            sum[0] += L[i];
+            sum[1] += a[i];
+            sum[2] += b[i];
+            sumOfSquares[0] += (double) L[i] * L[i];
+            sumOfSquares[1] += (double) a[i] * a[i];
+            sumOfSquares[2] += (double) b[i] * b[i];
+
+            // the same scaling as CIELCHColour::RGBtoCIELCH
+            const float lightness = L[i] / 100.0f;
+
+            acc.lightness[jlimit(0, lastBin, (int) (lightness * binScale))] += 1.0;
+            acc.chroma[jlimit(0, lastBin, (int) (C[i] * binScale))] += 1.0;
+            acc.hue[jlimit(0, lastBin, (int) (H[i] * binScale))] += C[i];
+
+            if (C[i] < neutralChroma)
+                ++numNeutral;
+        }
+
+        for (int i = 0; i < 3; ++i)
+        {
+            acc.sum[i] += sum[i];
+            acc.sumOfSquares[i] += sumOfSquares[i];
+        }
+
+        acc.numPixels += num;
+        acc.numNeutral += numNeutral;
+    }
+}
+
+//==============================================================================
+CIELCHImageStatistics::CIELCHImageStatistics(int bins) noexcept
+    : numBins(jmax(1, bins))
+{
+    reset();
+}
+
+CIELCHImageStatistics::CIELCHImageStatistics(const Image& image, int bins, float neutralChroma,
+                                             CIELCHPrecision precision)
+    : numBins(jmax(1, bins))
+{
+    analyse(image, neutralChroma, precision);
+}
+
+void CIELCHImageStatistics::reset() noexcept
+{
+    numPixels = 0;
+    neutralFraction = 0.0f;
+
+    lightnessHistogram.clearQuick();
+    chromaHistogram.clearQuick();
+    hueHistogram.clearQuick();
+
+    for (int i = 0; i < numBins; ++i)
+    {
+        lightnessHistogram.add(0.0);
+        chromaHistogram.add(0.0);
+        hueHistogram.add(0.0);
+    }
+
+    for (int i = 0; i < 3; ++i)
+        mean[i] = variance[i] = 0.0;
+}
+
+void CIELCHImageStatistics::analyse(const Image& image, float neutralChroma, CIELCHPrecision precision)
+{
+    reset();
+
+    if (!image.isValid())
+        return;
+
+    const Image::BitmapData data(image, Image::BitmapData::readOnly);
+    const int numWorkers = CIELCHParallel::getNumWorkers(data.width, data.height);
+
+    OwnedArray<Accumulator> accumulators;
+    for (int i = 0; i < numWorkers; ++i)
+        accumulators.add(new Accumulator(numBins));
+
+    const int bins = numBins;
+    const CIELCHConverter converter(precision);
+
+    CIELCHParallel::forEachRowRange(data.width, data.height, [&](int startRow, int endRow, int worker)
+    {
+        Accumulator& acc = *accumulators.getUnchecked(worker);
+        HeapBlock<PixelARGB> pixels((size_t) data.width);
+        HeapBlock<float> L((size_t) data.width), a((size_t) data.width), b((size_t) data.width);
+        HeapBlock<float> C((size_t) data.width), H((size_t) data.width);
+
+        for (int y = startRow; y < endRow; ++y)
+        {
+            const int num = CIELCHImageLine::readVisible(data, y, pixels, nullptr);
+
+            converter.RGBtoCIELab(pixels, L, a, b, num);
+            converter.CIELabtoCIELCH(a, b, C, H, num);
+            accumulateLine(acc, bins, neutralChroma, L, a, b, C, H, num);
+        }
+    });
+
+    //merge the results of all workers
+    int64 numNeutral = 0;
+    double sum[3] = { 0.0, 0.0, 0.0 };
+    double sumOfSquares[3] = { 0.0, 0.0, 0.0 };
+
+    for (int w = 0; w < numWorkers; ++w)
+    {
+        const Accumulator& acc = *accumulators.getUnchecked(w);
+
+        for (int i = 0; i < numBins; ++i)
+        {
+            lightnessHistogram.getReference(i) += acc.lightness[i];
+            chromaHistogram.getReference(i) += acc.chroma[i];
+            hueHistogram.getReference(i) += acc.hue[i];
+        }
+
+        for (int i = 0; i < 3; ++i)
+        {
+            sum[i] += acc.sum[i];
+            sumOfSquares[i] += acc.sumOfSquares[i];
+        }
+
+        numPixels += acc.numPixels;
+        numNeutral += acc.numNeutral;
+    }
+
+    if (numPixels > 0)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            mean[i] = sum[i] / (double) numPixels;
+            variance[i] = jmax(0.0, sumOfSquares[i] / (double) numPixels - mean[i] * mean[i]);
+        }
+
+        neutralFraction = (float) ((double) numNeutral / (double) numPixels);
+    }
+}
@@ -0,0 +1,137 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+#ifndef CIELCHImageStatistics_H_INCLUDED
+#define CIELCHImageStatistics_H_INCLUDED
+
+//==============================================================================
+/**
+Colour statistics of a JUCE Image in the CIE LCH and CIE Lab colour spaces.
+
+The statistics are collected in a single pass over the image. The rows are converted in bulk
+(see CIELCHConversion) and distributed over all CPU cores. Every worker fills its
+own histograms, which are merged when all workers have finished.
+
+Fully transparent pixels are ignored. The colour of all other pixels is taken without its
+alpha, i.e. like Image::getPixelAt() returns it.
+
+Here an example on how to use the class:
+@code
+CIELCHImageStatistics stats(img);
+if (stats.getNeutralFraction() > 0.9f)
+    std::cout << "Mostly grey image with mean lightness " << stats.getMeanL();
+@endcode
+*/
+class CIELCHImageStatistics
+{
+public:
+
+    /** Creates empty statistics, with all histograms having numBins bins. */
+    explicit CIELCHImageStatistics(int numBins = 64) noexcept;
+
+    /** Analyses an image.
+    @param image = the image to analyse. All pixel formats are supported.
+    @param numBins = the number of bins of each of the lightness, chroma and hue histograms
+    @param neutralChroma = pixels with a chroma (in the range 0...1) below this value count as neutral.
+    @param precision = the precision of the colour conversions, see CIELCHPrecision. By default
+                       the one of CIELCHConverter::getDefaultPrecision().
+    @see analyse
+    */
+    CIELCHImageStatistics(const Image& image, int numBins = 64, float neutralChroma = 0.02f,
+                          CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision());
+
+    /** Replaces the statistics with the ones of the given image.
+    @see CIELCHImageStatistics(const Image&, int, float, CIELCHPrecision)
+    */
+    void analyse(const Image& image, float neutralChroma = 0.02f,
+                 CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision());
+
+    //==============================================================================
+    /** Returns the number of bins of each histogram. */
+    int getNumBins() const noexcept                             { return numBins; }
+
+    /** Returns the number of pixels which have been analysed (i.e. non transparent pixels). */
+    int64 getNumPixels() const noexcept                         { return numPixels; }
+
+    /** Returns the lightness histogram.
+    Bin i counts the pixels with a CIE lightness (in the range 0...1) in [i / numBins, (i + 1) / numBins).
+    */
+    const Array<double>& getLightnessHistogram() const noexcept { return lightnessHistogram; }
+
+    /** Returns the chroma histogram.
+    Bin i counts the pixels with a CIE chroma (in the range 0...1) in [i / numBins, (i + 1) / numBins).
+    */
+    const Array<double>& getChromaHistogram() const noexcept    { return chromaHistogram; }
+
+    /** Returns the hue histogram.
+    Every pixel adds its CIE chroma (in the range 0...1) to the bin of its hue. So greyish pixels,
+    whose hue is more or less random, hardly contribute to the histogram.
+    */
+    const Array<double>& getHueHistogram() const noexcept       { return hueHistogram; }
+
+    //==============================================================================
+    /** Returns the mean CIE lightness, in the range 0...100 */
+    double getMeanL() const noexcept                            { return mean[0]; }
+    /** Returns the mean of the CIE Lab a component */
+    double getMeanA() const noexcept                            { return mean[1]; }
+    /** Returns the mean of the CIE Lab b component */
+    double getMeanB() const noexcept                            { return mean[2]; }
+
+    /** Returns the variance of the CIE lightness */
+    double getVarianceL() const noexcept                        { return variance[0]; }
+    /** Returns the variance of the CIE Lab a component */
+    double getVarianceA() const noexcept                        { return variance[1]; }
+    /** Returns the variance of the CIE Lab b component */
+    double getVarianceB() const noexcept                        { return variance[2]; }
+
+    /** Returns the fraction (0...1) of the analysed pixels, which are near neutral (grey).
+    @see CIELCHImageStatistics(const Image&, int, float, CIELCHPrecision)
+    */
+    float getNeutralFraction() const noexcept                   { return neutralFraction; }
+
+private:
+
+    void reset() noexcept;
+
+    int numBins;
+    int64 numPixels = 0;
+    Array<double> lightnessHistogram, chromaHistogram, hueHistogram;
+    double mean[3], variance[3];
+    float neutralFraction = 0.0f;
+
+    JUCE_LEAK_DETECTOR(CIELCHImageStatistics)
+};
+
+
+#endif  // CIELCHImageStatistics_H_INCLUDED
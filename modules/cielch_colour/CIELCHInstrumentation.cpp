@@ -0,0 +1,265 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+namespace
+{
+    /** The names of the CIELCHInstrumentation::EntryPoint values */
+    const char* const entryPointNames[] =
+    {
+        "fromCIELCH", "getCIELCH", "withCIELightness", "withCIEChroma", "withCIEHue",
+        "withMultipliedCIELightness", "withMultipliedCIEChroma", "withRotatedCIEHue",
+        "CIELighter", "CIEDarker", "RGBtoXYZ", "XYZtoRGB", "XYZtoCIELab", "CIELabtoXYZ",
+        "CIELabtoCIELCH", "CIELCHtoCIELab", "CIELCHtoRGB", "RGBtoCIELCH",
+        "RGBtoCIELab (line)", "CIELabtoRGB (line)"
+    };
+
+    static_assert(numElementsInArray(entryPointNames) == CIELCHInstrumentation::numEntryPoints,
+                  "one name per entry point");
+
+    const char* const stageNames[] = { "gamma", "matrix", "companding", "polar" };
+
+    static_assert(numElementsInArray(stageNames) == CIELCHInstrumentation::numStages,
+                  "one name per stage");
+
+   #if CIELCH_ENABLE_INSTRUMENTATION
+    typedef CIELCHInstrumentation::Snapshot Snapshot;
+
+    /** The counters of one thread. Only the owning thread writes them, so an increment is a
+    relaxed load and store; the atomics only make the reads of other threads well defined.
+    */
+    struct ThreadCounters
+    {
+        std::atomic<uint64> calls[CIELCHInstrumentation::numEntryPoints];
+        std::atomic<uint64> imaginaryColours;
+        std::atomic<uint64> stageSamples[CIELCHInstrumentation::numStages];
+        std::atomic<int64> stageTicks[CIELCHInstrumentation::numStages];
+
+        /** Counts the executions of each stage, to time every 16th. Not shared. */
+        uint32 stageExecutions[CIELCHInstrumentation::numStages];
+
+        /** The next thread in the registry. A linked list, so registering does not allocate. */
+        ThreadCounters* next = nullptr;
+
+        ThreadCounters() noexcept
+        {
+            for (auto& c : calls)           c.store(0, std::memory_order_relaxed);
+            for (auto& s : stageSamples)    s.store(0, std::memory_order_relaxed);
+            for (auto& t : stageTicks)      t.store(0, std::memory_order_relaxed);
+            for (auto& e : stageExecutions) e = 0;
+            imaginaryColours.store(0, std::memory_order_relaxed);
+        }
+
+        template <typename Type>
+        static void add(std::atomic<Type>& counter, Type amount) noexcept
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+        void addTo(Snapshot& s) const noexcept
+        {
+            for (int i = 0; i < CIELCHInstrumentation::numEntryPoints; ++i)
+                s.calls[i] += calls[i].load(std::memory_order_relaxed);
+
+            for (int i = 0; i < CIELCHInstrumentation::numStages; ++i)
+            {
+                s.stageSamples[i] += stageSamples[i].load(std::memory_order_relaxed);
+                s.stageTicks[i] += stageTicks[i].load(std::memory_order_relaxed);
+            }
+
+            s.imaginaryColours += imaginaryColours.load(std::memory_order_relaxed);
+        }
+    };
+
+    void add(Snapshot& s, const Snapshot& other, int sign) noexcept
+    {
+        for (int i = 0; i < CIELCHInstrumentation::numEntryPoints; ++i)
+            s.calls[i] += (uint64) sign * other.calls[i];
+
+        for (int i = 0; i < CIELCHInstrumentation::numStages; ++i)
+        {
+            s.stageSamples[i] += (uint64) sign * other.stageSamples[i];
+            s.stageTicks[i] += sign * other.stageTicks[i];
+        }
+
+        s.imaginaryColours += (uint64) sign * other.imaginaryColours;
+    }
+
+    /** All live threads, plus the totals of the threads which have ended and of the last reset */
+    struct Registry
+    {
+        CriticalSection lock;
+        ThreadCounters* threads = nullptr;
+        Snapshot endedThreads, atLastReset;
+
+        Snapshot getTotals() const noexcept
+        {
+            Snapshot s = endedThreads;
+
+            for (const ThreadCounters* t = threads; t != nullptr; t = t->next)
+                t->addTo(s);
+
+            return s;
+        }
+    };
+
+    Registry& getRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    /** Registers the counters of a thread on its first count, and keeps them when it ends */
+    struct RegisteredThreadCounters
+    {
+        RegisteredThreadCounters()
+        {
+            Registry& r = getRegistry();
+            const ScopedLock sl(r.lock);
+            counters.next = r.threads;
+            r.threads = &counters;
+        }
+
+        ~RegisteredThreadCounters()
+        {
+            Registry& r = getRegistry();
+            const ScopedLock sl(r.lock);
+            counters.addTo(r.endedThreads);
+
+            for (ThreadCounters** t = &r.threads; *t != nullptr; t = &(*t)->next)
+            {
+                if (*t == &counters)
+                {
+                    *t = counters.next;
+                    break;
+                }
+            }
+        }
+
+        ThreadCounters counters;
+    };
+
+    ThreadCounters& getThreadCounters() noexcept
+    {
+        thread_local RegisteredThreadCounters local;
+        return local.counters;
+    }
+   #endif
+}
+
+//==============================================================================
+double CIELCHInstrumentation::Snapshot::getAverageStageSeconds(Stage stage) const noexcept
+{
+    if (stageSamples[stage] == 0)
+        return 0.0;
+
+    return Time::highResolutionTicksToSeconds(stageTicks[stage]) / (double) stageSamples[stage];
+}
+
+String CIELCHInstrumentation::Snapshot::toString() const
+{
+    String s;
+
+    for (int i = 0; i < numEntryPoints; ++i)
+        if (calls[i] > 0)
+            s << entryPointNames[i] << ": " << String((int64) calls[i]) << newLine;
+
+    if (imaginaryColours > 0)
+        s << "imaginary colours: " << String((int64) imaginaryColours) << newLine;
+
+    for (int i = 0; i < numStages; ++i)
+        if (stageSamples[i] > 0)
+            s << stageNames[i] << ": " << String(getAverageStageSeconds((Stage) i) * 1.0e9, 1) << " ns" << newLine;
+
+    return s;
+}
+
+//==============================================================================
+CIELCHInstrumentation::Snapshot CIELCHInstrumentation::getSnapshot()
+{
+   #if CIELCH_ENABLE_INSTRUMENTATION
+    Registry& r = getRegistry();
+    const ScopedLock sl(r.lock);
+
+    Snapshot s = r.getTotals();
+    add(s, r.atLastReset, -1);
+    return s;
+   #else
+    return Snapshot();
+   #endif
+}
+
+void CIELCHInstrumentation::reset()
+{
+   #if CIELCH_ENABLE_INSTRUMENTATION
+    Registry& r = getRegistry();
+    const ScopedLock sl(r.lock);
+    r.atLastReset = r.getTotals();
+   #endif
+}
+
+const char* CIELCHInstrumentation::getName(EntryPoint entryPoint) noexcept
+{
+    return isPositiveAndBelow((int) entryPoint, (int) numEntryPoints) ? entryPointNames[entryPoint] : "";
+}
+
+const char* CIELCHInstrumentation::getName(Stage stage) noexcept
+{
+    return isPositiveAndBelow((int) stage, (int) numStages) ? stageNames[stage] : "";
+}
+
+//==============================================================================
+#if CIELCH_ENABLE_INSTRUMENTATION
+void CIELCHInstrumentation::countCall(EntryPoint entryPoint) noexcept
+{
+    ThreadCounters::add(getThreadCounters().calls[entryPoint], (uint64) 1);
+}
+
+void CIELCHInstrumentation::countImaginary(int numImaginary) noexcept
+{
+    if (numImaginary > 0)
+        ThreadCounters::add(getThreadCounters().imaginaryColours, (uint64) numImaginary);
+}
+
+bool CIELCHInstrumentation::shouldTimeStage(Stage stage) noexcept
+{
+    return (getThreadCounters().stageExecutions[stage]++ & 15) == 0;
+}
+
+void CIELCHInstrumentation::addStageTicks(Stage stage, int64 ticks) noexcept
+{
+    ThreadCounters& counters = getThreadCounters();
+    ThreadCounters::add(counters.stageSamples[stage], (uint64) 1);
+    ThreadCounters::add(counters.stageTicks[stage], ticks);
+}
+#endif
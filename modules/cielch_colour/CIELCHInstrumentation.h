@@ -0,0 +1,199 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+#ifndef CIELCHInstrumentation_H_INCLUDED
+#define CIELCHInstrumentation_H_INCLUDED
+
+//==============================================================================
+/**
+Counts how often the CIELCHColour conversions are called, how many imaginary colours they
+produce, and optionally how much time their stages take.
+
+The counting is compiled in only if CIELCH_ENABLE_INSTRUMENTATION is 1. Otherwise the hooks in
+CIELCHColour are empty macros, and getSnapshot() returns zeros, so code which reads the
+counters does not need its own #if.
+
+Every thread counts into its own counters, so counting needs no locks and no atomic
+read-modify-write operations. getSnapshot() adds up the counters of all threads, including
+threads which have ended. reset() does not touch the counters of other threads; it only
+remembers the current totals, which later snapshots subtract. Counting does not allocate,
+except for the first count on each thread: the C++ runtime may allocate when it registers the
+clean-up of the thread's counters.
+
+Calls are counted per entry point, including the calls which entry points make to each other:
+e.g. one call of withCIEChroma also counts one getCIELCH, one RGBtoCIELCH, one fromCIELCH etc.
+
+With CIELCH_ENABLE_STAGE_TIMING, every 16th execution of a stage (per thread) is timed with
+Time::getHighResolutionTicks(). The timer itself costs some tens of nanoseconds, so the stage
+times are only useful to compare the stages with each other.
+
+Here an example which logs the conversions of each repaint:
+@code
+void MyComponent::paint(Graphics& g)
+{
+    CIELCHInstrumentation::reset();
+    drawEverything(g);
+
+    const CIELCHInstrumentation::Snapshot s = CIELCHInstrumentation::getSnapshot();
+    DBG(s.getNumCalls(CIELCHInstrumentation::fromCIELCH) << " fromCIELCH, "
+        << s.imaginaryColours << " imaginary");
+}
+@endcode
+*/
+class CIELCHInstrumentation
+{
+public:
+
+    /** The counted functions of CIELCHColour */
+    enum EntryPoint
+    {
+        fromCIELCH,
+        getCIELCH,
+        withCIELightness,
+        withCIEChroma,
+        withCIEHue,
+        withMultipliedCIELightness,
+        withMultipliedCIEChroma,
+        withRotatedCIEHue,
+        CIELighter,
+        CIEDarker,
+        RGBtoXYZ,
+        XYZtoRGB,
+        XYZtoCIELab,
+        CIELabtoXYZ,
+        CIELabtoCIELCH,
+        CIELCHtoCIELab,
+        CIELCHtoRGB,
+        RGBtoCIELCH,
+        RGBtoCIELabLine,        /**< the line conversion CIELCHColour::RGBtoCIELab */
+        CIELabtoRGBLine,        /**< the line conversion CIELCHColour::CIELabtoRGB */
+        numEntryPoints
+    };
+
+    /** The timed stages of the conversions */
+    enum Stage
+    {
+        gamma,          /**< sRGB gamma expansion and compression */
+        matrix,         /**< the matrix multiplications between linear RGB and XYZ */
+        companding,     /**< the cube root and its inverse between XYZ and CIE Lab */
+        polar,          /**< the conversions between CIE Lab and CIE LCH */
+        numStages
+    };
+
+    //==============================================================================
+    /** The counters of all threads, added up */
+    struct Snapshot
+    {
+        uint64 calls[numEntryPoints] = {};
+
+        /** Imaginary colours from XYZtoRGB and the line conversion CIELabtoRGB */
+        uint64 imaginaryColours = 0;
+
+        /** The number of timed executions of each stage, and their total time in ticks */
+        uint64 stageSamples[numStages] = {};
+        int64 stageTicks[numStages] = {};
+
+        uint64 getNumCalls(EntryPoint entryPoint) const noexcept   { return calls[entryPoint]; }
+
+        /** Returns the average time of one execution of a stage in seconds, or 0 if it was never timed. */
+        double getAverageStageSeconds(Stage stage) const noexcept;
+
+        /** Lists all non-zero counters, one per line. */
+        String toString() const;
+    };
+
+    /** Returns true if the counters are compiled in. */
+    static constexpr bool isEnabled() noexcept      { return CIELCH_ENABLE_INSTRUMENTATION != 0; }
+
+    /** Returns the counters of all threads since the last reset(). */
+    static Snapshot getSnapshot();
+
+    /** Starts counting from zero again. */
+    static void reset();
+
+    static const char* getName(EntryPoint entryPoint) noexcept;
+    static const char* getName(Stage stage) noexcept;
+
+    //==============================================================================
+   #if CIELCH_ENABLE_INSTRUMENTATION
+    /** @internal The hooks, called through the macros below */
+    static void countCall(EntryPoint entryPoint) noexcept;
+    static void countImaginary(int numImaginary) noexcept;
+    static bool shouldTimeStage(Stage stage) noexcept;
+    static void addStageTicks(Stage stage, int64 ticks) noexcept;
+
+    /** @internal Times a stage from its creation to the end of the scope */
+    class ScopedStageTimer
+    {
+    public:
+        explicit ScopedStageTimer(Stage s) noexcept
+            : stage(s), start(shouldTimeStage(s) ? Time::getHighResolutionTicks() : 0) {}
+
+        ~ScopedStageTimer() noexcept
+        {
+            if (start != 0)
+                addStageTicks(stage, Time::getHighResolutionTicks() - start);
+        }
+
+    private:
+        const Stage stage;
+        const int64 start;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedStageTimer)
+    };
+   #endif
+
+private:
+
+    CIELCHInstrumentation() = delete;
+};
+
+//==============================================================================
+#if CIELCH_ENABLE_INSTRUMENTATION
+ #define CIELCH_COUNT_CALL(entryPoint)      CIELCHInstrumentation::countCall(CIELCHInstrumentation::entryPoint)
+ #define CIELCH_COUNT_IMAGINARY(number)     CIELCHInstrumentation::countImaginary(number)
+#else
+ #define CIELCH_COUNT_CALL(entryPoint)
+ #define CIELCH_COUNT_IMAGINARY(number)
+#endif
+
+#if CIELCH_ENABLE_STAGE_TIMING
+ #define CIELCH_TIME_STAGE(stage) \
+    const CIELCHInstrumentation::ScopedStageTimer JUCE_JOIN_MACRO(cielchStageTimer, __LINE__)(CIELCHInstrumentation::stage)
+#else
+ #define CIELCH_TIME_STAGE(stage)
+#endif
+
+
+#endif  // CIELCHInstrumentation_H_INCLUDED
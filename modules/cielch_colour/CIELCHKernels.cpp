@@ -0,0 +1,221 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+#if JUCE_INTEL && (JUCE_GCC || JUCE_CLANG)
+ #define CIELCH_TARGET_KERNELS 1
+#else
+ #define CIELCH_TARGET_KERNELS 0
+#endif
+
+namespace
+{
+    enum { numInstructionSets = (int) CIELCHInstructionSet::avx512 + 1 };
+
+    //==============================================================================
+    template <CIELCHPrecision precision>
+    struct GenericKernels
+    {
+        typedef CIELCHConversion<precision> Conversion;
+
+        static void rgbToLab(const PixelARGB* p, float* L, float* a, float* b, int n) noexcept        { Conversion::RGBtoCIELab(p, L, a, b, n); }
+        static int  labToRgb(const float* L, const float* a, const float* b, PixelARGB* p, int n) noexcept  { return Conversion::CIELabtoRGB(L, a, b, p, n); }
+        static void labToLch(const float* a, const float* b, float* C, float* H, int n) noexcept     { Conversion::CIELabtoCIELCH(a, b, C, H, n); }
+        static void lchToLab(const float* C, const float* H, float* a, float* b, int n) noexcept     { Conversion::CIELCHtoCIELab(C, H, a, b, n); }
+        static void rgbToLch(const PixelARGB* p, float* L, float* C, float* H, int n) noexcept        { Conversion::RGBtoCIELCH(p, L, C, H, n); }
+        static int  lchToRgb(const float* L, const float* C, const float* H, PixelARGB* p, int n) noexcept  { return Conversion::CIELCHtoRGB(L, C, H, p, n); }
+    };
+
+   #if CIELCH_TARGET_KERNELS
+    // The same kernels compiled for one instruction set. flatten inlines the whole conversion
+    // into the kernel, so that all of it is compiled (and vectorised) for the target, and none
+    // of it is shared with the generic code.
+    #define CIELCH_DECLARE_TARGET_KERNELS(KernelsName, targetName) \
+    template <CIELCHPrecision precision> \
+    struct KernelsName \
+    { \
+        typedef CIELCHConversion<precision> Conversion; \
+    \
+        __attribute__ ((target (targetName), flatten)) static void rgbToLab(const PixelARGB* p, float* L, float* a, float* b, int n) noexcept        { Conversion::RGBtoCIELab(p, L, a, b, n); } \
+        __attribute__ ((target (targetName), flatten)) static int  labToRgb(const float* L, const float* a, const float* b, PixelARGB* p, int n) noexcept  { return Conversion::CIELabtoRGB(L, a, b, p, n); } \
+        __attribute__ ((target (targetName), flatten)) static void labToLch(const float* a, const float* b, float* C, float* H, int n) noexcept     { Conversion::CIELabtoCIELCH(a, b, C, H, n); } \
+        __attribute__ ((target (targetName), flatten)) static void lchToLab(const float* C, const float* H, float* a, float* b, int n) noexcept     { Conversion::CIELCHtoCIELab(C, H, a, b, n); } \
+        __attribute__ ((target (targetName), flatten)) static void rgbToLch(const PixelARGB* p, float* L, float* C, float* H, int n) noexcept        { Conversion::RGBtoCIELCH(p, L, C, H, n); } \
+        __attribute__ ((target (targetName), flatten)) static int  lchToRgb(const float* L, const float* C, const float* H, PixelARGB* p, int n) noexcept  { return Conversion::CIELCHtoRGB(L, C, H, p, n); } \
+    };
+
+    CIELCH_DECLARE_TARGET_KERNELS (SSE2Kernels,   "sse2")
+    CIELCH_DECLARE_TARGET_KERNELS (SSE41Kernels,  "sse4.1")
+    CIELCH_DECLARE_TARGET_KERNELS (AVX2Kernels,   "avx2,fma")
+    CIELCH_DECLARE_TARGET_KERNELS (AVX512Kernels, "avx512f,avx512bw,avx512dq,avx512vl,avx2,fma")
+
+    #undef CIELCH_DECLARE_TARGET_KERNELS
+   #endif
+
+    template <template <CIELCHPrecision> class Kernels, CIELCHPrecision precision>
+    CIELCHKernels::Functions makeFunctions() noexcept
+    {
+        CIELCHKernels::Functions functions;
+        functions.RGBtoCIELab    = Kernels<precision>::rgbToLab;
+        functions.CIELabtoRGB    = Kernels<precision>::labToRgb;
+        functions.CIELabtoCIELCH = Kernels<precision>::labToLch;
+        functions.CIELCHtoCIELab = Kernels<precision>::lchToLab;
+        functions.RGBtoCIELCH    = Kernels<precision>::rgbToLch;
+        functions.CIELCHtoRGB    = Kernels<precision>::lchToRgb;
+        return functions;
+    }
+
+    //==============================================================================
+    /** The kernels of all instruction sets, indexed by instruction set and precision */
+    struct KernelTable
+    {
+        KernelTable() noexcept
+        {
+            for (int set = 0; set < numInstructionSets; ++set)
+            {
+                functions[set][0] = makeFunctions<GenericKernels, CIELCHPrecision::exact>();
+                functions[set][1] = makeFunctions<GenericKernels, CIELCHPrecision::fast>();
+                functions[set][2] = makeFunctions<GenericKernels, CIELCHPrecision::fastest>();
+            }
+
+           #if CIELCH_TARGET_KERNELS
+            setTargetFunctions<SSE2Kernels>   (CIELCHInstructionSet::sse2);
+            setTargetFunctions<SSE41Kernels>  (CIELCHInstructionSet::sse41);
+            setTargetFunctions<AVX2Kernels>   (CIELCHInstructionSet::avx2);
+            setTargetFunctions<AVX512Kernels> (CIELCHInstructionSet::avx512);
+           #endif
+        }
+
+        template <template <CIELCHPrecision> class Kernels>
+        void setTargetFunctions(CIELCHInstructionSet set) noexcept
+        {
+            // the exact kernels stay generic
+            functions[(int) set][1] = makeFunctions<Kernels, CIELCHPrecision::fast>();
+            functions[(int) set][2] = makeFunctions<Kernels, CIELCHPrecision::fastest>();
+        }
+
+        CIELCHKernels::Functions functions[numInstructionSets][3];
+    };
+
+    const KernelTable& getKernelTable() noexcept
+    {
+        static const KernelTable table;
+        return table;
+    }
+
+    bool isSupportedByCPU(CIELCHInstructionSet set) noexcept
+    {
+        switch (set)
+        {
+            case CIELCHInstructionSet::sse2:    return SystemStats::hasSSE2();
+            case CIELCHInstructionSet::sse41:   return SystemStats::hasSSE41();
+            case CIELCHInstructionSet::avx2:    return SystemStats::hasAVX2() && SystemStats::hasFMA3();
+            case CIELCHInstructionSet::avx512:  return SystemStats::hasAVX512F() && SystemStats::hasAVX512BW()
+                                                    && SystemStats::hasAVX512DQ() && SystemStats::hasAVX512VL();
+            case CIELCHInstructionSet::generic:
+            default:                            return true;
+        }
+    }
+
+    /** The forced instruction set, or -1 for the best available one */
+    std::atomic<int> forcedInstructionSet { -1 };
+}
+
+//==============================================================================
+const CIELCHKernels::Functions& CIELCHKernels::getFunctions(CIELCHPrecision precision) noexcept
+{
+    const int set = (int) getInstructionSet();
+
+    switch (precision)
+    {
+        case CIELCHPrecision::fast:     return getKernelTable().functions[set][1];
+        case CIELCHPrecision::fastest:  return getKernelTable().functions[set][2];
+        case CIELCHPrecision::exact:
+        default:                        return getKernelTable().functions[set][0];
+    }
+}
+
+CIELCHInstructionSet CIELCHKernels::getInstructionSet() noexcept
+{
+    const int forced = forcedInstructionSet.load();
+    return forced >= 0 ? (CIELCHInstructionSet) forced : getBestInstructionSet();
+}
+
+CIELCHInstructionSet CIELCHKernels::getBestInstructionSet() noexcept
+{
+    static const CIELCHInstructionSet best = []
+    {
+        for (int set = numInstructionSets; --set > 0;)
+            if (isAvailable((CIELCHInstructionSet) set))
+                return (CIELCHInstructionSet) set;
+
+        return CIELCHInstructionSet::generic;
+    }();
+
+    return best;
+}
+
+bool CIELCHKernels::isAvailable(CIELCHInstructionSet instructionSet) noexcept
+{
+    if (instructionSet == CIELCHInstructionSet::generic)
+        return true;
+
+    return CIELCH_TARGET_KERNELS && isSupportedByCPU(instructionSet);
+}
+
+bool CIELCHKernels::setInstructionSet(CIELCHInstructionSet instructionSet) noexcept
+{
+    if (! isAvailable(instructionSet))
+        return false;
+
+    forcedInstructionSet = (int) instructionSet;
+    return true;
+}
+
+void CIELCHKernels::resetInstructionSet() noexcept
+{
+    forcedInstructionSet = -1;
+}
+
+const char* CIELCHKernels::getName(CIELCHInstructionSet instructionSet) noexcept
+{
+    switch (instructionSet)
+    {
+        case CIELCHInstructionSet::sse2:    return "sse2";
+        case CIELCHInstructionSet::sse41:   return "sse4.1";
+        case CIELCHInstructionSet::avx2:    return "avx2";
+        case CIELCHInstructionSet::avx512:  return "avx512";
+        case CIELCHInstructionSet::generic:
+        default:                            return "generic";
+    }
+}
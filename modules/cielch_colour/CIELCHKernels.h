@@ -0,0 +1,129 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+#ifndef CIELCHKernels_H_INCLUDED
+#define CIELCHKernels_H_INCLUDED
+
+//==============================================================================
+/**
+The instruction sets for which the line conversions of CIELCHConversion are compiled.
+@see CIELCHKernels
+*/
+enum class CIELCHInstructionSet
+{
+    generic,    /**< The default target of the compiler. Always available. */
+    sse2,       /**< SSE2 */
+    sse41,      /**< SSE2 to SSE4.1 */
+    avx2,       /**< AVX2 and FMA */
+    avx512      /**< AVX-512 F, BW, DQ and VL, plus AVX2 and FMA */
+};
+
+//==============================================================================
+/**
+Run-time CPU dispatch for the line conversions of CIELCHConversion.
+
+The fast and fastest conversions contain no branches in their inner loops, so the compiler can
+vectorise them. To use the wider vectors of newer CPUs without compiling the whole module
+for them, the conversions are compiled a second time for each instruction set, using function
+target attributes (GCC and Clang on x86 only; with other compilers only the generic kernels exist).
+The best instruction set the CPU supports is detected the first time the kernels are used.
+
+The exact conversions are always the generic ones, so that they stay identical to the
+CIELCHColour functions. The kernels for the other instruction sets may use fused multiply-adds,
+so their results can differ from the generic ones in the last bit of a float.
+
+CIELCHConverter binds the kernels of the active instruction set when it is created. For tests
+and benchmarks the instruction set can be forced with setInstructionSet():
+@code
+for (auto set : { CIELCHInstructionSet::generic, CIELCHInstructionSet::sse41, CIELCHInstructionSet::avx2 })
+{
+    if (CIELCHKernels::setInstructionSet(set))
+    {
+        CIELCHConverter converter(CIELCHPrecision::fast);
+        DBG(CIELCHKernels::getName(set) << ": " << timeConversion(converter));
+    }
+}
+
+CIELCHKernels::resetInstructionSet();
+@endcode
+*/
+class CIELCHKernels
+{
+public:
+
+    /** The line conversions of one precision, compiled for one instruction set.
+    @see CIELCHConversion
+    */
+    struct Functions
+    {
+        void (*RGBtoCIELab)(const PixelARGB* pixels, float* L, float* a, float* b, int numPixels) noexcept;
+        int  (*CIELabtoRGB)(const float* L, const float* a, const float* b, PixelARGB* pixels, int numPixels) noexcept;
+        void (*CIELabtoCIELCH)(const float* a, const float* b, float* C, float* H, int numValues) noexcept;
+        void (*CIELCHtoCIELab)(const float* C, const float* H, float* a, float* b, int numValues) noexcept;
+        void (*RGBtoCIELCH)(const PixelARGB* pixels, float* L, float* C, float* H, int numPixels) noexcept;
+        int  (*CIELCHtoRGB)(const float* L, const float* C, const float* H, PixelARGB* pixels, int numPixels) noexcept;
+    };
+
+    /** Returns the kernels of the active instruction set for the given precision. */
+    static const Functions& getFunctions(CIELCHPrecision precision) noexcept;
+
+    //==============================================================================
+    /** Returns the instruction set whose kernels are currently used. */
+    static CIELCHInstructionSet getInstructionSet() noexcept;
+
+    /** Returns the best instruction set which is both compiled in and supported by this CPU. */
+    static CIELCHInstructionSet getBestInstructionSet() noexcept;
+
+    /** Returns true if the kernels for the instruction set are compiled in and this CPU supports it. */
+    static bool isAvailable(CIELCHInstructionSet instructionSet) noexcept;
+
+    /** Forces the kernels of an instruction set, for testing and benchmarking.
+    Only converters created afterwards use the new kernels.
+    @returns false, and leaves the kernels unchanged, if the instruction set is not available.
+    */
+    static bool setInstructionSet(CIELCHInstructionSet instructionSet) noexcept;
+
+    /** Goes back to the best available instruction set after setInstructionSet(). */
+    static void resetInstructionSet() noexcept;
+
+    /** Returns a short name of the instruction set, like "avx2". */
+    static const char* getName(CIELCHInstructionSet instructionSet) noexcept;
+
+private:
+
+    CIELCHKernels() = delete;
+};
+
+
+#endif  // CIELCHKernels_H_INCLUDED
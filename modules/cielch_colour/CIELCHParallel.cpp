@@ -0,0 +1,73 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+int CIELCHParallel::getNumWorkers(int width, int height) noexcept
+{
+    // below this many pixels per worker, the thread start-up dominates
+    const int64 minPixelsPerWorker = 64 * 1024;
+
+    const int64 numPixels = (int64) width * (int64) height;
+    const int64 maxByPixels = jmax((int64) 1, numPixels / minPixelsPerWorker);
+
+    return (int) jmin((int64) SystemStats::getNumCpus(), maxByPixels, (int64) jmax(1, height));
+}
+
+void CIELCHParallel::forEachRowRange(int width, int height, const RowRangeFunction& function)
+{
+    if (width <= 0 || height <= 0)
+        return;
+
+    const int numWorkers = getNumWorkers(width, height);
+
+    if (numWorkers == 1)
+    {
+        function(0, height, 0);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve((size_t) numWorkers - 1);
+
+    for (int worker = 1; worker < numWorkers; ++worker)
+    {
+        const int startRow = (int) (((int64) height * worker) / numWorkers);
+        const int endRow   = (int) (((int64) height * (worker + 1)) / numWorkers);
+        threads.emplace_back(function, startRow, endRow, worker);
+    }
+
+    function(0, (int) ((int64) height / numWorkers), 0);
+
+    for (auto& t : threads)
+        t.join();
+}
@@ -0,0 +1,71 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+#ifndef CIELCHParallel_H_INCLUDED
+#define CIELCHParallel_H_INCLUDED
+
+//==============================================================================
+/**
+Splits per-row image work across all CPU cores.
+
+The rows are divided into one contiguous band per worker. Each band is handed to the
+callback together with the index of the worker, so that callers can give every worker
+its own accumulators (histograms, sums...) and merge them once all workers are done.
+The calling thread always processes the first band itself.
+*/
+class CIELCHParallel
+{
+public:
+
+    /** The callback receives the first row, one past the last row and the worker index. */
+    typedef std::function<void(int startRow, int endRow, int workerIndex)> RowRangeFunction;
+
+    /** Returns the number of workers forEachRowRange() will use for an image of the given size.
+    Small images are processed on fewer workers, because starting threads would cost more than
+    it saves.
+    */
+    static int getNumWorkers(int width, int height) noexcept;
+
+    /** Calls the function for contiguous bands of rows on getNumWorkers(width, height)
+    threads and returns when all bands have been processed.
+    */
+    static void forEachRowRange(int width, int height, const RowRangeFunction& function);
+
+private:
+
+    CIELCHParallel() = delete;
+};
+
+
+#endif  // CIELCHParallel_H_INCLUDED
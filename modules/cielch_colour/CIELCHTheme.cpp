@@ -0,0 +1,389 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+namespace
+{
+    typedef CIELCHConversion<CIELCHPrecision::exact> ThemeConversion;
+
+    /** Headroom on the contrast ratios, for the rounding to 8-bit channels */
+    const float themeContrastMargin = 1.02f;
+
+    /** The lightness steps of CIELCHColour::CIELighter() and CIELCHColour::CIEDarker() */
+    inline float getThemeLighter(float L, float amount) noexcept    { return 1.0f - (1.0f - L) / (1.0f + amount); }
+    inline float getThemeDarker(float L, float amount) noexcept     { return L / (1.0f + amount); }
+
+    /** Returns the relative luminance Y (0...1) of a CIE lightness (0...1) */
+    float getThemeLuminance(float L) noexcept
+    {
+        const float labL = 100.0f * jlimit(0.0f, 1.0f, L);
+
+        if (labL > 8.0f)
+        {
+            const float f = (labL + 16.0f) / 116.0f;
+            return f * f * f;
+        }
+
+        return labL / 903.3f;
+    }
+
+    /** Returns the CIE lightness (0...1) of a relative luminance Y (0...1) */
+    float getThemeLightness(float Y) noexcept
+    {
+        Y = jlimit(0.0f, 1.0f, Y);
+        return (Y > 0.008856f ? 116.0f * std::cbrt(Y) - 16.0f : 903.3f * Y) / 100.0f;
+    }
+
+    float getThemeContrastRatio(float firstY, float secondY) noexcept
+    {
+        return (jmax(firstY, secondY) + 0.05f) / (jmin(firstY, secondY) + 0.05f);
+    }
+
+    /** Returns the lightness closest to the preferred one which has at least the given contrast
+    ratio to all the surfaces. If there is none, the end of the lightness range which comes closest.
+    */
+    float getThemeTextLightness(float preferred, std::initializer_list<float> surfaces, float ratio) noexcept
+    {
+        ratio *= themeContrastMargin;
+
+        float minLighterY = 0.0f, maxDarkerY = 1.0f;
+        float worstWhite = 21.0f, worstBlack = 21.0f;
+
+        for (float surfaceL : surfaces)
+        {
+            const float Y = getThemeLuminance(surfaceL);
+
+            minLighterY = jmax(minLighterY, ratio * (Y + 0.05f) - 0.05f);
+            maxDarkerY  = jmin(maxDarkerY, (Y + 0.05f) / ratio - 0.05f);
+            worstWhite  = jmin(worstWhite, getThemeContrastRatio(1.0f, Y));
+            worstBlack  = jmin(worstBlack, getThemeContrastRatio(0.0f, Y));
+        }
+
+        const bool lighterPossible = minLighterY <= 1.0f;
+        const bool darkerPossible  = maxDarkerY >= 0.0f;
+        const float minLighter = getThemeLightness(minLighterY);
+        const float maxDarker  = getThemeLightness(maxDarkerY);
+
+        if ((lighterPossible && preferred >= minLighter) || (darkerPossible && preferred <= maxDarker))
+            return preferred;
+
+        if (lighterPossible && darkerPossible)
+            return (minLighter - preferred <= preferred - maxDarker) ? minLighter : maxDarker;
+
+        if (lighterPossible)
+            return minLighter;
+
+        if (darkerPossible)
+            return maxDarker;
+
+        return worstWhite >= worstBlack ? 1.0f : 0.0f;
+    }
+}
+
+//==============================================================================
+CIELCHTheme::CIELCHTheme(const CIELCHColour& backgroundSeed, const CIELCHColour& accentSeed) noexcept
+{
+    float backgroundLCH[3], accentLCH[3];
+    backgroundSeed.getCIELCH(backgroundLCH[0], backgroundLCH[1], backgroundLCH[2]);
+    accentSeed.getCIELCH(accentLCH[0], accentLCH[1], accentLCH[2]);
+
+    build(backgroundLCH, accentLCH);
+}
+
+CIELCHTheme CIELCHTheme::fromAccent(const CIELCHColour& accentSeed, bool dark) noexcept
+{
+    float accentLCH[3];
+    accentSeed.getCIELCH(accentLCH[0], accentLCH[1], accentLCH[2]);
+
+    const float backgroundLCH[3] = { dark ? 0.15f : 0.97f, jmin(accentLCH[1], 0.04f), accentLCH[2] };
+
+    CIELCHTheme theme;
+    theme.build(backgroundLCH, accentLCH);
+    return theme;
+}
+
+void CIELCHTheme::build(const float* backgroundLCH, const float* accentLCH) noexcept
+{
+    const float bL = backgroundLCH[0], bC = backgroundLCH[1], bH = backgroundLCH[2];
+    const float aL = accentLCH[0],     aC = accentLCH[1],     aH = accentLCH[2];
+
+    const float textRatio = 4.5f, disabledTextRatio = 3.0f;
+
+    // a dark theme is one where white text has more contrast on the background than black text
+    const float backgroundY = getThemeLuminance(bL);
+    dark = getThemeContrastRatio(1.0f, backgroundY) >= getThemeContrastRatio(0.0f, backgroundY);
+
+    // surfaces are raised towards the text: lighter on dark themes, darker on light ones, but not
+    // past the lightness where even white or black text loses its contrast ratio
+    const float surfaceLimit = dark ? getThemeLightness(1.05f / (textRatio * themeContrastMargin) - 0.05f)
+                                    : getThemeLightness(0.05f * textRatio * themeContrastMargin - 0.05f);
+
+    const auto raise = [=] (float amount) noexcept
+    {
+        return dark ? jmax(bL, jmin(getThemeLighter(bL, amount), surfaceLimit))
+                    : jmin(bL, jmax(getThemeDarker(bL, amount), surfaceLimit));
+    };
+
+    // the accent shades move away from the text on the accent
+    const float accentY = getThemeLuminance(aL);
+    const bool lightTextOnAccent = getThemeContrastRatio(1.0f, accentY) >= getThemeContrastRatio(0.0f, accentY);
+
+    const auto shadeAccent = [=] (float amount) noexcept
+    {
+        return lightTextOnAccent ? getThemeDarker(aL, amount) : getThemeLighter(aL, amount);
+    };
+
+    float L[numRoles], C[numRoles], H[numRoles], alpha[numRoles];
+
+    const auto set = [&] (Role role, float lightness, float chroma, float hue, float opacity = 1.0f) noexcept
+    {
+        L[role] = lightness;
+        C[role] = chroma;
+        H[role] = hue;
+        alpha[role] = opacity;
+    };
+
+    set(background,         bL,                                 bC,             bH);
+    set(surface,            raise(0.1f),                        bC,             bH);
+    set(surfaceHover,       raise(0.2f),                        bC,             bH);
+    set(surfacePressed,     raise(0.32f),                       bC,             bH);
+    set(surfaceDisabled,    raise(0.05f),                       bC * 0.5f,      bH);
+    set(accent,             aL,                                 aC,             aH);
+    set(accentHover,        shadeAccent(0.12f),                 aC,             aH);
+    set(accentPressed,      shadeAccent(0.25f),                 aC,             aH);
+    set(accentDisabled,     0.5f * (aL + L[surface]),           aC * 0.3f,      aH);
+    set(outline,            dark ? getThemeLighter(bL, 0.6f) : getThemeDarker(bL, 0.6f),
+                                                                bC,             bH);
+    set(focusOutline,       aL,                                 aC,             aH);
+    set(selection,          aL + 0.45f * (bL - aL),             aC * 0.6f,      aH);
+    set(shadow,             0.0f,                               0.0f,           0.0f,   dark ? 0.6f : 0.25f);
+
+    // the text colours are nearly neutral, so that they stay inside sRGB at any lightness
+    const float textChroma = jmin(bC, 0.03f);
+    const float textL = getThemeTextLightness(dark ? 0.94f : 0.1f,
+                                              { L[background], L[surface], L[surfaceHover], L[surfacePressed] }, textRatio);
+
+    set(text,               textL,                              textChroma,     bH);
+
+    set(secondaryText,      getThemeTextLightness(textL + 0.3f * (bL - textL),
+                                                  { L[background], L[surface] }, textRatio),
+                                                                textChroma,     bH);
+
+    set(disabledText,       getThemeTextLightness(textL + 0.55f * (bL - textL),
+                                                  { L[background], L[surfaceDisabled] }, disabledTextRatio),
+                                                                textChroma,     bH);
+
+    set(textOnAccent,       getThemeTextLightness(lightTextOnAccent ? 0.98f : 0.08f,
+                                                  { L[accent], L[accentHover], L[accentPressed] }, textRatio),
+                                                                jmin(aC, 0.03f), aH);
+
+    set(selectedText,       getThemeTextLightness(textL, { L[selection] }, textRatio),
+                                                                textChroma,     bH);
+
+    // all roles in one pass; only the imaginary ones are mapped into sRGB, by reducing the
+    // chroma at the same lightness, which keeps the luminance and so the contrast ratios
+    PixelARGB pixels[numRoles];
+    bool imaginary[numRoles];
+
+    if (ThemeConversion::CIELCHtoRGB(L, C, H, pixels, numRoles, imaginary) > 0)
+    {
+        for (int i = 0; i < numRoles; ++i)
+        {
+            if (! imaginary[i])
+                continue;
+
+            C[i] = jmin(C[i], CIELCHConversionTables::getMaxChroma(L[i], H[i]));
+
+            // close to the cusps the max chroma grid can still be slightly outside
+            while (ThemeConversion::CIELCHtoRGB(L[i], C[i], H[i], pixels[i]) && C[i] > 0.0f)
+                C[i] = jmax(0.0f, C[i] - 0.005f);
+        }
+    }
+
+    for (int i = 0; i < numRoles; ++i)
+        colours[i] = Colour(pixels[i].getRed(), pixels[i].getGreen(), pixels[i].getBlue(), alpha[i]);
+}
+
+Colour CIELCHTheme::getColour(Role role) const noexcept
+{
+    jassert(role >= 0 && role < numRoles);
+    return colours[role];
+}
+
+//==============================================================================
+LookAndFeel_V4::ColourScheme CIELCHTheme::getColourScheme() const
+{
+    return LookAndFeel_V4::ColourScheme(colours[background],    // windowBackground
+                                        colours[surface],       // widgetBackground
+                                        colours[surface],       // menuBackground
+                                        colours[outline],       // outline
+                                        colours[text],          // defaultText
+                                        colours[accent],        // defaultFill
+                                        colours[selectedText],  // highlightedText
+                                        colours[selection],     // highlightedFill
+                                        colours[text]);         // menuText
+}
+
+void CIELCHTheme::applyTo(LookAndFeel& lookAndFeel) const
+{
+    // the V4 scheme resets every colour ID, so it has to come first
+    if (auto* lookAndFeelV4 = dynamic_cast<LookAndFeel_V4*>(&lookAndFeel))
+        lookAndFeelV4->setColourScheme(getColourScheme());
+
+    const struct { int colourID; Role role; } settings[] =
+    {
+        { ResizableWindow::backgroundColourId,                  background },
+        { DocumentWindow::textColourId,                         text },
+        { AlertWindow::backgroundColourId,                      surface },
+        { AlertWindow::textColourId,                            text },
+        { AlertWindow::outlineColourId,                         outline },
+        { TooltipWindow::backgroundColourId,                    surfacePressed },
+        { TooltipWindow::textColourId,                          text },
+        { TooltipWindow::outlineColourId,                       outline },
+        { BubbleComponent::backgroundColourId,                  surfacePressed },
+        { BubbleComponent::outlineColourId,                     outline },
+
+        { TextButton::buttonColourId,                           surface },
+        { TextButton::buttonOnColourId,                         accent },
+        { TextButton::textColourOffId,                          text },
+        { TextButton::textColourOnId,                           textOnAccent },
+        { ToggleButton::textColourId,                           text },
+        { ToggleButton::tickColourId,                           text },
+        { ToggleButton::tickDisabledColourId,                   disabledText },
+        { HyperlinkButton::textColourId,                        accent },
+        { DrawableButton::textColourId,                         text },
+        { DrawableButton::textColourOnId,                       textOnAccent },
+        { DrawableButton::backgroundColourId,                   surface },
+        { DrawableButton::backgroundOnColourId,                 accent },
+
+        { TextEditor::backgroundColourId,                       surface },
+        { TextEditor::textColourId,                             text },
+        { TextEditor::highlightColourId,                        selection },
+        { TextEditor::highlightedTextColourId,                  selectedText },
+        { TextEditor::outlineColourId,                          outline },
+        { TextEditor::focusedOutlineColourId,                   focusOutline },
+        { TextEditor::shadowColourId,                           shadow },
+        { CaretComponent::caretColourId,                        accent },
+
+        { Label::textColourId,                                  text },
+        { Label::backgroundWhenEditingColourId,                 surface },
+        { Label::textWhenEditingColourId,                       text },
+        { Label::outlineWhenEditingColourId,                    focusOutline },
+
+        { ComboBox::backgroundColourId,                         surface },
+        { ComboBox::textColourId,                               text },
+        { ComboBox::outlineColourId,                            outline },
+        { ComboBox::buttonColourId,                             surfaceHover },
+        { ComboBox::arrowColourId,                              secondaryText },
+        { ComboBox::focusedOutlineColourId,                     focusOutline },
+
+        { PopupMenu::backgroundColourId,                        surface },
+        { PopupMenu::textColourId,                              text },
+        { PopupMenu::headerTextColourId,                        secondaryText },
+        { PopupMenu::highlightedBackgroundColourId,             selection },
+        { PopupMenu::highlightedTextColourId,                   selectedText },
+
+        { Slider::backgroundColourId,                           surfacePressed },
+        { Slider::thumbColourId,                                accent },
+        { Slider::trackColourId,                                accent },
+        { Slider::rotarySliderFillColourId,                     accent },
+        { Slider::rotarySliderOutlineColourId,                  surfacePressed },
+        { Slider::textBoxTextColourId,                          text },
+        { Slider::textBoxBackgroundColourId,                    surface },
+        { Slider::textBoxHighlightColourId,                     selection },
+        { Slider::textBoxOutlineColourId,                       outline },
+
+        { ScrollBar::backgroundColourId,                        background },
+        { ScrollBar::thumbColourId,                             surfacePressed },
+        { ScrollBar::trackColourId,                             surface },
+        { ProgressBar::backgroundColourId,                      surface },
+        { ProgressBar::foregroundColourId,                      accent },
+
+        { ListBox::backgroundColourId,                          surface },
+        { ListBox::outlineColourId,                             outline },
+        { ListBox::textColourId,                                text },
+        { TreeView::backgroundColourId,                         surface },
+        { TreeView::linesColourId,                              outline },
+        { TreeView::dragAndDropIndicatorColourId,               focusOutline },
+        { TreeView::selectedItemBackgroundColourId,             selection },
+
+        { TabbedComponent::backgroundColourId,                  background },
+        { TabbedComponent::outlineColourId,                     outline },
+        { TabbedButtonBar::tabOutlineColourId,                  outline },
+        { TabbedButtonBar::tabTextColourId,                     secondaryText },
+        { TabbedButtonBar::frontOutlineColourId,                focusOutline },
+        { TabbedButtonBar::frontTextColourId,                   text },
+        { GroupComponent::outlineColourId,                      outline },
+        { GroupComponent::textColourId,                         text },
+
+        { Toolbar::backgroundColourId,                          surface },
+        { Toolbar::separatorColourId,                           outline },
+        { Toolbar::buttonMouseOverBackgroundColourId,           surfaceHover },
+        { Toolbar::buttonMouseDownBackgroundColourId,           surfacePressed },
+        { Toolbar::labelTextColourId,                           text },
+        { Toolbar::editingModeOutlineColourId,                  focusOutline },
+
+        { PropertyComponent::backgroundColourId,                surface },
+        { PropertyComponent::labelTextColourId,                 text },
+        { TextPropertyComponent::backgroundColourId,            surface },
+        { TextPropertyComponent::textColourId,                  text },
+        { TextPropertyComponent::outlineColourId,               outline },
+        { BooleanPropertyComponent::backgroundColourId,         surface },
+        { BooleanPropertyComponent::outlineColourId,            outline },
+
+        { DirectoryContentsDisplayComponent::highlightColourId, selection },
+        { DirectoryContentsDisplayComponent::textColourId,      text },
+        { FileChooserDialogBox::titleTextColourId,              text }
+    };
+
+    for (const auto& setting : settings)
+        lookAndFeel.setColour(setting.colourID, colours[setting.role]);
+}
+
+float CIELCHTheme::getContrastRatio(const Colour& first, const Colour& second) noexcept
+{
+    const auto getLuminance = [] (const Colour& colour) noexcept
+    {
+        const auto linearise = [] (uint8 channel) noexcept
+        {
+            const float value = channel / 255.0f;
+            return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+        };
+
+        return 0.2126f * linearise(colour.getRed())
+             + 0.7152f * linearise(colour.getGreen())
+             + 0.0722f * linearise(colour.getBlue());
+    };
+
+    return getThemeContrastRatio(getLuminance(first), getLuminance(second));
+}
@@ -0,0 +1,142 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+#ifndef CIELCHTheme_H_INCLUDED
+#define CIELCHTheme_H_INCLUDED
+
+//==============================================================================
+/**
+A complete set of LookAndFeel colours, derived from one or two seed colours in CIE LCH.
+
+Backgrounds, surfaces, their hover, pressed and disabled shades, outlines, selections and text
+colours are all derived from a background and an accent seed. The shades follow the same
+lightness steps as CIELCHColour::CIELighter() and CIELCHColour::CIEDarker(): a dark background
+gets lighter surfaces, a light background gets darker ones, up to the lightness where text still
+has enough contrast. The hover and pressed accents move away from the text on the accent.
+
+Every text colour is placed at a lightness which keeps a WCAG 2 contrast ratio of at least
+4.5:1 to each surface it is drawn on (3:1 for disabled text). In CIE Lab the luminance only
+depends on the lightness, so the chroma reduction which maps a colour into sRGB does not change
+the contrast.
+
+The seeds are converted to CIE LCH once, all roles are computed in float, converted to sRGB in a
+single pass and only the imaginary roles are mapped into the gamut by reducing their chroma. A
+theme is built in a few microseconds, and applyTo() writes it straight into a LookAndFeel, so
+switching themes live costs little more than the repaint.
+
+This class is only available if the juce_gui_basics module is used.
+
+Here an example on how to use the class:
+@code
+const CIELCHTheme theme(CIELCHColour(Colour(0xff1e2128)), CIELCHColour(Colours::orange));
+theme.applyTo(getLookAndFeel());
+sendLookAndFeelChange();
+
+// custom components can use the shades which have no colour ID
+g.setColour(theme.getColour(isMouseOver() ? CIELCHTheme::surfaceHover : CIELCHTheme::surface));
+@endcode
+*/
+class CIELCHTheme
+{
+public:
+
+    enum Role
+    {
+        background,         /**< the window background, the background seed */
+        surface,            /**< buttons, text boxes, menus, raised from the background */
+        surfaceHover,       /**< a surface under the mouse */
+        surfacePressed,     /**< a surface which is pressed */
+        surfaceDisabled,    /**< a disabled surface, close to the background */
+        accent,             /**< filled parts of widgets, the accent seed */
+        accentHover,        /**< the accent under the mouse */
+        accentPressed,      /**< the accent while pressed */
+        accentDisabled,     /**< the accent of a disabled widget */
+        outline,            /**< outlines and separators */
+        focusOutline,       /**< the outline of the focused widget */
+        text,               /**< text on the background and all surfaces */
+        secondaryText,      /**< less important text, on the background and surfaces */
+        disabledText,       /**< text of disabled widgets */
+        textOnAccent,       /**< text on the accent and its hover and pressed shades */
+        selection,          /**< the background of selected text and items */
+        selectedText,       /**< text on the selection */
+        shadow,             /**< drop shadows, translucent */
+
+        numRoles
+    };
+
+    //==============================================================================
+    /** Derives a theme from a background and an accent colour.
+    The theme is dark if white text has more contrast on the background than black text.
+    */
+    CIELCHTheme(const CIELCHColour& backgroundSeed, const CIELCHColour& accentSeed) noexcept;
+
+    /** Derives a theme from an accent colour, with a nearly neutral background of the accent's hue. */
+    static CIELCHTheme fromAccent(const CIELCHColour& accentSeed, bool dark) noexcept;
+
+    /** Returns true if the theme has light text on a dark background. */
+    bool isDark() const noexcept                        { return dark; }
+
+    /** Returns the colour of a role. */
+    Colour getColour(Role role) const noexcept;
+
+    //==============================================================================
+    /** Returns the theme as a colour scheme for LookAndFeel_V4. */
+    LookAndFeel_V4::ColourScheme getColourScheme() const;
+
+    /** Writes the theme into all colour IDs of the juce_gui_basics components.
+    If the LookAndFeel is a LookAndFeel_V4, its colour scheme is set first.
+    The components pick up the new colours on their next repaint; call
+    Component::sendLookAndFeelChange() to repaint them all.
+    */
+    void applyTo(LookAndFeel& lookAndFeel) const;
+
+    //==============================================================================
+    /** Returns the WCAG 2 contrast ratio of two colours, in the range 1...21.
+    The alpha values are ignored.
+    */
+    static float getContrastRatio(const Colour& first, const Colour& second) noexcept;
+
+private:
+
+    CIELCHTheme() noexcept {}
+
+    void build(const float* backgroundLCH, const float* accentLCH) noexcept;
+
+    bool dark = false;
+    Colour colours[numRoles];
+
+    JUCE_LEAK_DETECTOR(CIELCHTheme)
+};
+
+
+#endif  // CIELCHTheme_H_INCLUDED
@@ -0,0 +1,239 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+template <typename FunctionType>
+CIELCHToneCurve CIELCHToneCurve::fromFunction(FunctionType function)
+{
+    CIELCHToneCurve curve;
+
+    for (int i = 0; i <= CIELCHConversionTables::tableSize; ++i)
+        curve.table.set(i, (float) function((float) i / (float) CIELCHConversionTables::tableSize));
+
+    return curve;
+}
+
+CIELCHToneCurve::CIELCHToneCurve()
+{
+    table.ensureStorageAllocated(CIELCHConversionTables::tableSize + 1);
+
+    for (int i = 0; i <= CIELCHConversionTables::tableSize; ++i)
+        table.add((float) i / (float) CIELCHConversionTables::tableSize);
+}
+
+CIELCHToneCurve CIELCHToneCurve::contrast(float amount)
+{
+    amount = jlimit(-1.0f, 1.0f, amount);
+
+    // blends between the identity and a smoothstep S-curve. For negative amounts the blend is
+    // extrapolated, which gives the inverse shape and stays monotonic and inside 0...1.
+    return fromFunction([amount] (float x)
+    {
+        const float s = x * x * (3.0f - 2.0f * x);
+        return x + amount * (s - x);
+    });
+}
+
+CIELCHToneCurve CIELCHToneCurve::gamma(float gamma)
+{
+    // a gamma of 0 or less would not be a meaningful curve
+    jassert(gamma > 0.0f);
+
+    const float exponent = 1.0f / jmax(0.001f, gamma);
+    return fromFunction([exponent] (float x) { return std::pow(x, exponent); });
+}
+
+CIELCHToneCurve CIELCHToneCurve::levels(float inputBlack, float inputWhite, float gamma,
+                                        float outputBlack, float outputWhite)
+{
+    // an empty input range would not be a meaningful curve
+    jassert(inputWhite > inputBlack);
+
+    const float inputRange = jmax(0.001f, inputWhite - inputBlack);
+    const float exponent = 1.0f / jmax(0.001f, gamma);
+
+    return fromFunction([=] (float x)
+    {
+        const float stretched = jlimit(0.0f, 1.0f, (x - inputBlack) / inputRange);
+        return outputBlack + std::pow(stretched, exponent) * (outputWhite - outputBlack);
+    });
+}
+
+CIELCHToneCurve CIELCHToneCurve::spline(const Array<Point<float>>& unsortedPoints)
+{
+    std::vector<Point<float>> points(unsortedPoints.begin(), unsortedPoints.end());
+
+    std::sort(points.begin(), points.end(), [] (Point<float> first, Point<float> second)
+    {
+        return first.x < second.x;
+    });
+
+    // points with the same x would make the slopes infinite, only the first one is kept
+    points.erase(std::unique(points.begin(), points.end(), [] (Point<float> first, Point<float> second)
+    {
+        return first.x == second.x;
+    }), points.end());
+
+    const size_t n = points.size();
+
+    if (n == 0)
+        return CIELCHToneCurve();
+
+    if (n == 1)
+        return fromFunction([&] (float) { return points[0].y; });
+
+    // Fritsch-Carlson monotone cubic interpolation
+    std::vector<float> secants(n - 1), tangents(n);
+
+    for (size_t k = 0; k + 1 < n; ++k)
+        secants[k] = (points[k + 1].y - points[k].y) / (points[k + 1].x - points[k].x);
+
+    tangents[0] = secants[0];
+    tangents[n - 1] = secants[n - 2];
+
+    for (size_t k = 1; k + 1 < n; ++k)
+        tangents[k] = secants[k - 1] * secants[k] > 0.0f ? 0.5f * (secants[k - 1] + secants[k]) : 0.0f;
+
+    for (size_t k = 0; k + 1 < n; ++k)
+    {
+        if (secants[k] == 0.0f)
+        {
+            tangents[k] = tangents[k + 1] = 0.0f;
+            continue;
+        }
+
+        const float alpha = tangents[k] / secants[k];
+        const float beta = tangents[k + 1] / secants[k];
+        const float lengthSquared = alpha * alpha + beta * beta;
+
+        if (lengthSquared > 9.0f)
+        {
+            const float tau = 3.0f / std::sqrt(lengthSquared);
+            tangents[k] = tau * alpha * secants[k];
+            tangents[k + 1] = tau * beta * secants[k];
+        }
+    }
+
+    size_t segment = 0;
+
+    // the table is filled in order of x, so the segment only ever moves forward
+    return fromFunction([&] (float x)
+    {
+        if (x <= points[0].x)
+            return points[0].y;
+
+        if (x >= points[n - 1].x)
+            return points[n - 1].y;
+
+        while (points[segment + 1].x < x)
+            ++segment;
+
+        const float h = points[segment + 1].x - points[segment].x;
+        const float t = (x - points[segment].x) / h;
+        const float t2 = t * t, t3 = t2 * t;
+
+        return (2.0f * t3 - 3.0f * t2 + 1.0f) * points[segment].y
+             + (t3 - 2.0f * t2 + t) * h * tangents[segment]
+             + (-2.0f * t3 + 3.0f * t2) * points[segment + 1].y
+             + (t3 - t2) * h * tangents[segment + 1];
+    });
+}
+
+CIELCHToneCurve CIELCHToneCurve::followedBy(const CIELCHToneCurve& other) const
+{
+    return fromFunction([&] (float x) { return other.getValue(getValue(x)); });
+}
+
+//==============================================================================
+void CIELCHToneCurve::applyToCIELab(float* L, float* a, float* b, int numPixels,
+                                    const CIELCHToneCurve* chromaCurve) const noexcept
+{
+    const float* lightness = table.getRawDataPointer();
+
+    for (int i = 0; i < numPixels; ++i)
+        L[i] = jlimit(0.0f, 100.0f, 100.0f * CIELCHConversionTables::lookup(lightness, jlimit(0.0f, 1.0f, L[i] * 0.01f)));
+
+    if (chromaCurve != nullptr)
+    {
+        const float* chroma = chromaCurve->table.getRawDataPointer();
+
+        for (int i = 0; i < numPixels; ++i)
+        {
+            // scaling a and b changes the chroma and keeps the hue
+            const float multiplier = jmax(0.0f, CIELCHConversionTables::lookup(chroma, L[i] * 0.01f));
+            a[i] *= multiplier;
+            b[i] *= multiplier;
+        }
+    }
+}
+
+void CIELCHToneCurve::applyTo(Image& image, const CIELCHToneCurve* chromaCurve, CIELCHPrecision precision) const
+{
+    if (!image.isValid() || image.getFormat() == Image::SingleChannel)
+        return;
+
+    const CIELCHConverter converter(precision);
+
+    // flat artwork has few colours, so each of them is converted only once
+    const bool fewColours = CIELCHUniqueColours::applyIfFewColours(image, [&](PixelARGB* pixels, int num)
+    {
+        HeapBlock<float> L((size_t) num), a((size_t) num), b((size_t) num);
+
+        converter.RGBtoCIELab(pixels, L, a, b, num);
+        applyToCIELab(L, a, b, num, chromaCurve);
+        converter.CIELabtoRGB(L, a, b, pixels, num);
+    });
+
+    if (fewColours)
+        return;
+
+    const Image::BitmapData data(image, Image::BitmapData::readWrite);
+
+    CIELCHParallel::forEachRowRange(data.width, data.height, [&](int startRow, int endRow, int)
+    {
+        HeapBlock<PixelARGB> pixels((size_t) data.width);
+        HeapBlock<int> positions((size_t) data.width);
+        HeapBlock<float> L((size_t) data.width), a((size_t) data.width), b((size_t) data.width);
+
+        for (int y = startRow; y < endRow; ++y)
+        {
+            // the alpha doesn't change, so fully transparent pixels are skipped
+            const int num = CIELCHImageLine::readVisible(data, y, pixels, positions);
+
+            converter.RGBtoCIELab(pixels, L, a, b, num);
+            applyToCIELab(L, a, b, num, chromaCurve);
+            converter.CIELabtoRGB(L, a, b, pixels, num);
+            CIELCHImageLine::writeVisible(data, y, pixels, positions, num);
+        }
+    });
+}
@@ -0,0 +1,130 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+#ifndef CIELCHToneCurve_H_INCLUDED
+#define CIELCHToneCurve_H_INCLUDED
+
+//==============================================================================
+/**
+A tone curve (contrast, gamma, levels or a spline) which is applied to the CIE lightness only.
+
+Because only the lightness changes, hues stay exactly as they are, which is not the case for
+curves applied to the R, G and B channels. Optionally a second curve multiplies the chroma
+depending on the new lightness, e.g. to desaturate the shadows.
+
+A curve maps values in the range 0...1 to new values. When it is created, it is sampled into a
+dense table, so applying it costs one interpolated table lookup per pixel. Create a new curve
+whenever the user edits it, and apply it to the original image each time.
+
+The colours are only converted to CIE Lab and back: scaling a and b changes the chroma and keeps
+the hue, so no conversion to polar coordinates is needed.
+
+Here an example on how to use the class:
+@code
+const CIELCHToneCurve curve = CIELCHToneCurve::levels(0.05f, 0.9f, 1.2f)
+                                  .followedBy(CIELCHToneCurve::contrast(0.3f));
+curve.applyTo(img);
+@endcode
+*/
+class CIELCHToneCurve
+{
+public:
+
+    /** Creates the identity curve. */
+    CIELCHToneCurve();
+
+    /** Creates an S-shaped contrast curve.
+    amount is in the range -1...1: positive values increase the contrast, negative values reduce
+    it, 0 is the identity. The curve always maps 0 to 0, 0.5 to 0.5 and 1 to 1.
+    */
+    static CIELCHToneCurve contrast(float amount);
+
+    /** Creates a gamma curve x^(1 / gamma). Values above 1 brighten the mid tones. */
+    static CIELCHToneCurve gamma(float gamma);
+
+    /** Creates a levels adjustment like the one of image editors.
+    Input lightness between inputBlack and inputWhite is stretched to the full range, then the
+    gamma is applied, then the result is compressed to outputBlack...outputWhite.
+    */
+    static CIELCHToneCurve levels(float inputBlack, float inputWhite, float gamma = 1.0f,
+                                  float outputBlack = 0.0f, float outputWhite = 1.0f);
+
+    /** Creates a smooth curve through the given points, e.g. the points of a curve editor.
+    The points don't need to be sorted. Between them a monotone cubic spline is used, so the curve
+    doesn't overshoot. Left of the first and right of the last point the curve is flat.
+    Without points the identity is returned.
+    */
+    static CIELCHToneCurve spline(const Array<Point<float>>& points);
+
+    /** Returns a curve which applies this curve and then the other one. */
+    CIELCHToneCurve followedBy(const CIELCHToneCurve& other) const;
+
+    //==============================================================================
+    /** Returns the value of the curve at x, which is clamped to the range 0...1. */
+    float getValue(float x) const noexcept
+    {
+        return CIELCHConversionTables::lookup(table.getRawDataPointer(), jlimit(0.0f, 1.0f, x));
+    }
+
+    /** Applies the curve to numPixels CIE Lab values in place (L in the range 0...100).
+    If chromaCurve is not nullptr, a and b are then multiplied by chromaCurve->getValue(newL / 100).
+    */
+    void applyToCIELab(float* L, float* a, float* b, int numPixels,
+                       const CIELCHToneCurve* chromaCurve = nullptr) const noexcept;
+
+    /** Applies the curve to the lightness of all pixels of an image in place.
+    The work is split over all CPU cores. Images with few distinct colours convert each colour only
+    once, see CIELCHUniqueColours.
+    @param image = the image to adjust
+    @param chromaCurve = if not nullptr, the chroma of every pixel is multiplied by the value of
+                         this curve at the new lightness.
+    @param precision = the precision of the colour conversions, see CIELCHPrecision. By default
+                       the one of CIELCHConverter::getDefaultPrecision().
+    */
+    void applyTo(Image& image, const CIELCHToneCurve* chromaCurve = nullptr,
+                 CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision()) const;
+
+private:
+
+    template <typename FunctionType>
+    static CIELCHToneCurve fromFunction(FunctionType function);
+
+    /** CIELCHConversionTables::tableSize + 1 samples of the curve */
+    Array<float> table;
+
+    JUCE_LEAK_DETECTOR(CIELCHToneCurve)
+};
+
+
+#endif  // CIELCHToneCurve_H_INCLUDED
@@ -0,0 +1,379 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+namespace
+{
+    /** The memory of the pixels of an image, without the line padding */
+    size_t getImageSize(const Image& image) noexcept
+    {
+        const size_t bytesPerPixel = image.getFormat() == Image::ARGB ? 4 : (image.getFormat() == Image::RGB ? 3 : 1);
+        return image.isValid() ? (size_t) image.getWidth() * (size_t) image.getHeight() * bytesPerPixel : 0;
+    }
+}
+
+//==============================================================================
+class CIELCHTransformedImageCache::Pimpl  : private DeletedAtShutdown,
+                                            private ImagePixelData::Listener
+{
+public:
+
+    /** An entry is found by its source and its operation */
+    struct Key
+    {
+        int64 source;
+        int64 operation;
+        bool byIdentity;
+
+        bool operator==(const Key& other) const noexcept
+        {
+            return source == other.source && operation == other.operation && byIdentity == other.byIdentity;
+        }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const noexcept
+        {
+            uint64 h = (uint64) key.source * 0x9e3779b97f4a7c15ull;
+            h ^= (uint64) key.operation + 0x632be59bd9b4e019ull + (h << 6) + (h >> 2);
+            h ^= key.byIdentity ? 0xff51afd7ed558ccdull : 0;
+            return (size_t) (h ^ (h >> 29));
+        }
+    };
+
+    //==============================================================================
+    Pimpl() = default;
+
+    ~Pimpl()
+    {
+        // before the entries go, whose results may be watched sources themselves
+        const ScopedLock sl(watchLock);
+
+        for (auto* pixelData : watchedSources)
+            pixelData->listeners.remove(this);
+
+        watchedSources.clear();
+        clearSingletonInstance();
+    }
+
+    Image get(const Key& key, const Image& source, const CreateFunction& create)
+    {
+        const int shardIndex = getShardIndex(key);
+        Shard& shard = shards[shardIndex];
+
+        {
+            const ScopedLock sl(shard.lock);
+            auto found = shard.index.find(key);
+
+            if (found != shard.index.end())
+            {
+                shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+                ++hits;
+                return found->second->result;
+            }
+        }
+
+        ++misses;
+
+        const Image result = create(source);
+        const size_t numBytes = getImageSize(result);
+
+        // an image which doesn't fit into the budget would only evict everything else
+        if (numBytes > memoryBudget)
+            return result;
+
+        if (key.byIdentity)
+            watch(source.getPixelData());
+
+        {
+            const ScopedLock sl(shard.lock);
+            auto found = shard.index.find(key);
+
+            // another thread has created it in the meantime
+            if (found != shard.index.end())
+                return found->second->result;
+
+            shard.entries.push_front({ key, result, numBytes });
+            shard.index[key] = shard.entries.begin();
+            shard.numBytes += numBytes;
+            numBytesTotal += numBytes;
+            ++numImages;
+        }
+
+        trim(shardIndex);
+        return result;
+    }
+
+    void setMemoryBudget(size_t numBytes)
+    {
+        memoryBudget = numBytes;
+        trim(0);
+    }
+
+    size_t getMemoryBudget() const noexcept
+    {
+        return memoryBudget;
+    }
+
+    void clear()
+    {
+        for (auto& shard : shards)
+        {
+            std::vector<Image> released;
+            const ScopedLock sl(shard.lock);
+
+            while (! shard.entries.empty())
+                remove(shard, shard.entries.begin(), released);
+        }
+    }
+
+    Statistics getStatistics() const noexcept
+    {
+        Statistics stats;
+        stats.hits = hits;
+        stats.misses = misses;
+        stats.evictions = evictions;
+        stats.numImages = numImages;
+        stats.numBytes = numBytesTotal;
+        stats.memoryBudget = memoryBudget;
+        return stats;
+    }
+
+    void resetStatistics() noexcept
+    {
+        hits = 0;
+        misses = 0;
+        evictions = 0;
+    }
+
+    JUCE_DECLARE_SINGLETON(Pimpl, false)
+
+private:
+
+    enum { numShards = 16 };
+
+    struct Entry
+    {
+        Key key;
+        Image result;
+        size_t numBytes;
+    };
+
+    /** A part of the cache with its own lock. The entries are in the order of their last use. */
+    struct Shard
+    {
+        CriticalSection lock;
+        std::list<Entry> entries;
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+        size_t numBytes = 0;
+    };
+
+    /** All entries of a source are in the same shard, so that its entries can be dropped together */
+    static int getShardIndex(const Key& key) noexcept
+    {
+        const uint64 h = (uint64) key.source * 0x9e3779b97f4a7c15ull;
+        return (int) (h >> 60) % numShards;
+    }
+
+    /** Removes an entry. The result is moved into released, which the caller destroys after
+    unlocking the shard: the result may be the watched source of other entries, and dropping those
+    locks their shard (see imageDataBeingDeleted).
+    */
+    void remove(Shard& shard, std::list<Entry>::iterator entry, std::vector<Image>& released)
+    {
+        shard.numBytes -= entry->numBytes;
+        numBytesTotal -= entry->numBytes;
+        --numImages;
+
+        released.push_back(std::move(entry->result));
+        shard.index.erase(entry->key);
+        shard.entries.erase(entry);
+    }
+
+    //==============================================================================
+    /** Registers the cache as a listener of a source's pixel data, once */
+    void watch(ImagePixelData* pixelData)
+    {
+        const ScopedLock sl(watchLock);
+
+        if (watchedSources.insert(pixelData).second)
+            pixelData->listeners.add(this);
+    }
+
+    /** Drops the entries of a source, which nobody can look up or which are out of date */
+    void removeEntriesOf(ImagePixelData* pixelData)
+    {
+        const Key sourceKey { (int64) (pointer_sized_int) pixelData, 0, true };
+        Shard& shard = shards[getShardIndex(sourceKey)];
+
+        std::vector<Image> released;
+        const ScopedLock sl(shard.lock);
+
+        for (auto entry = shard.entries.begin(); entry != shard.entries.end();)
+        {
+            auto next = std::next(entry);
+
+            if (entry->key.byIdentity && entry->key.source == sourceKey.source)
+                remove(shard, entry, released);
+
+            entry = next;
+        }
+    }
+
+    void imageDataChanged(ImagePixelData* pixelData) override
+    {
+        removeEntriesOf(pixelData);
+    }
+
+    void imageDataBeingDeleted(ImagePixelData* pixelData) override
+    {
+        {
+            const ScopedLock sl(watchLock);
+            watchedSources.erase(pixelData);
+        }
+
+        removeEntriesOf(pixelData);
+    }
+
+    /** Evicts entries until the cache fits into the budget, starting with the shard of the last
+    insertion and keeping its newest entry. Only one shard is locked at a time.
+    */
+    void trim(int firstShard)
+    {
+        for (int i = 0; i < numShards && numBytesTotal > memoryBudget; ++i)
+        {
+            Shard& shard = shards[(firstShard + i) % numShards];
+            std::vector<Image> released;
+            const ScopedLock sl(shard.lock);
+
+            const size_t numToKeep = i == 0 ? 1 : 0;
+
+            while (numBytesTotal > memoryBudget && shard.entries.size() > numToKeep)
+            {
+                remove(shard, std::prev(shard.entries.end()), released);
+                ++evictions;
+            }
+        }
+    }
+
+    Shard shards[numShards];
+
+    CriticalSection watchLock;
+    std::unordered_set<ImagePixelData*> watchedSources;
+
+    std::atomic<size_t> memoryBudget { (size_t) defaultMemoryBudget };
+    std::atomic<size_t> numBytesTotal { 0 };
+    std::atomic<int> numImages { 0 };
+    std::atomic<uint64> hits { 0 }, misses { 0 }, evictions { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE(Pimpl)
+};
+
+JUCE_IMPLEMENT_SINGLETON(CIELCHTransformedImageCache::Pimpl)
+
+//==============================================================================
+Image CIELCHTransformedImageCache::get(const Image& source, int64 operationKey, const CreateFunction& create)
+{
+    const Pimpl::Key key { (int64) (pointer_sized_int) source.getPixelData(), operationKey, true };
+    return Pimpl::getInstance()->get(key, source, create);
+}
+
+Image CIELCHTransformedImageCache::get(int64 sourceHashCode, const Image& source, int64 operationKey,
+                                       const CreateFunction& create)
+{
+    const Pimpl::Key key { sourceHashCode, operationKey, false };
+    return Pimpl::getInstance()->get(key, source, create);
+}
+
+int64 CIELCHTransformedImageCache::getOperationKey(const char* operationName, std::initializer_list<float> parameters) noexcept
+{
+    // 64 bit FNV-1a over the name and the bits of the parameters
+    uint64 hash = 0xcbf29ce484222325ull;
+
+    for (const char* c = operationName; *c != 0; ++c)
+        hash = (hash ^ (uint8) *c) * 0x100000001b3ull;
+
+    for (float parameter : parameters)
+    {
+        uint32 bits;
+        std::memcpy(&bits, &parameter, sizeof(bits));
+
+        for (int i = 0; i < 4; ++i)
+            hash = (hash ^ ((bits >> (i * 8)) & 0xff)) * 0x100000001b3ull;
+    }
+
+    return (int64) hash;
+}
+
+//==============================================================================
+void CIELCHTransformedImageCache::setMemoryBudget(size_t numBytes)
+{
+    Pimpl::getInstance()->setMemoryBudget(numBytes);
+}
+
+size_t CIELCHTransformedImageCache::getMemoryBudget() noexcept
+{
+    if (auto* instance = Pimpl::getInstanceWithoutCreating())
+        return instance->getMemoryBudget();
+
+    return (size_t) defaultMemoryBudget;
+}
+
+void CIELCHTransformedImageCache::clear()
+{
+    if (auto* instance = Pimpl::getInstanceWithoutCreating())
+        instance->clear();
+}
+
+double CIELCHTransformedImageCache::Statistics::getHitRate() const noexcept
+{
+    const uint64 lookups = hits + misses;
+    return lookups > 0 ? (double) hits / (double) lookups : 0.0;
+}
+
+CIELCHTransformedImageCache::Statistics CIELCHTransformedImageCache::getStatistics() noexcept
+{
+    if (auto* instance = Pimpl::getInstanceWithoutCreating())
+        return instance->getStatistics();
+
+    Statistics stats;
+    stats.memoryBudget = (size_t) defaultMemoryBudget;
+    return stats;
+}
+
+void CIELCHTransformedImageCache::resetStatistics() noexcept
+{
+    if (auto* instance = Pimpl::getInstanceWithoutCreating())
+        instance->resetStatistics();
+}
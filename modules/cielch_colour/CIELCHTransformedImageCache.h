@@ -0,0 +1,149 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+#ifndef CIELCHTransformedImageCache_H_INCLUDED
+#define CIELCHTransformedImageCache_H_INCLUDED
+
+//==============================================================================
+/**
+A process-wide cache of processed images, e.g. the desaturated versions of icons which are drawn
+in their disabled state on every repaint.
+
+An entry is found by its source image and a key of the operation, e.g. one made with
+getOperationKey() from the name and the parameters of the operation. The source is identified
+either by its pixel data (the same Image object or a copy of it, like the images which ImageCache
+returns), or by a hash code of its contents which the caller provides.
+
+The cache doesn't keep the source images alive. It listens to the pixel data of its sources
+(see ImagePixelData::Listener) and drops their entries as soon as the pixel data is deleted, e.g.
+when ImageCache releases an icon which isn't used any more, or written to through an
+Image::BitmapData. Entries of sources which are identified by a hash code stay until they are
+evicted.
+
+The cache keeps the results within a memory budget and drops the least recently used ones first.
+It is split into shards with their own locks, so threads which paint at the same time rarely wait
+for each other. Like ImageCache, it is deleted at shutdown.
+
+The returned images are shared with the cache, so they must not be drawn into; use
+Image::createCopy() for that.
+
+Here an example on how to use the class:
+@code
+void IconButton::paintButton(Graphics& g, bool, bool)
+{
+    Image image = icon;
+
+    if (!isEnabled())
+    {
+        image = CIELCHTransformedImageCache::get(icon, CIELCHTransformedImageCache::getOperationKey("desaturate", { 0.2f }),
+                                                 [] (const Image& source)
+        {
+            Image result = source.createCopy();
+            CIELabPlaneTransform::chromaMultiplication(0.2f).applyTo(result);
+            return result;
+        });
+    }
+
+    g.drawImageAt(image, 0, 0);
+}
+@endcode
+*/
+class CIELCHTransformedImageCache
+{
+public:
+
+    /** The memory budget until setMemoryBudget() is called, in bytes */
+    enum { defaultMemoryBudget = 64 * 1024 * 1024 };
+
+    /** Creates the processed image from the source, on a cache miss. */
+    typedef std::function<Image(const Image& source)> CreateFunction;
+
+    /** Returns the processed image of a source, creating it if it isn't in the cache.
+    The source is identified by its pixel data. Its entries are dropped when the pixel data is
+    deleted or written to. As this registers a listener with the pixel data, the source must not be
+    written to or released by another thread during the call.
+    The create function is called without any lock held. If two threads miss the same entry at the
+    same time, both create it and both get the result which was stored first.
+    */
+    static Image get(const Image& source, int64 operationKey, const CreateFunction& create);
+
+    /** Returns the processed image of a source, which is identified by a hash code of its contents.
+    @see ImageCache::getFromHashCode
+    */
+    static Image get(int64 sourceHashCode, const Image& source, int64 operationKey, const CreateFunction& create);
+
+    /** Returns a key for an operation from its name and parameters. */
+    static int64 getOperationKey(const char* operationName, std::initializer_list<float> parameters) noexcept;
+
+    //==============================================================================
+    /** Sets the maximum memory of the cached images, in bytes. */
+    static void setMemoryBudget(size_t numBytes);
+
+    /** Returns the maximum memory of the cached images, in bytes. */
+    static size_t getMemoryBudget() noexcept;
+
+    /** Drops all entries. */
+    static void clear();
+
+    //==============================================================================
+    /** The counters and the size of the cache */
+    struct Statistics
+    {
+        uint64 hits = 0;
+        uint64 misses = 0;
+        uint64 evictions = 0;
+        int numImages = 0;
+        size_t numBytes = 0;
+        size_t memoryBudget = 0;
+
+        /** Returns hits / (hits + misses), or 0 if nothing was looked up. */
+        double getHitRate() const noexcept;
+    };
+
+    /** Returns the size of the cache, and the hits, misses and evictions since the start or since
+    the last resetStatistics().
+    */
+    static Statistics getStatistics() noexcept;
+
+    /** Sets the hits, misses and evictions to zero. */
+    static void resetStatistics() noexcept;
+
+private:
+
+    class Pimpl;
+
+    CIELCHTransformedImageCache() = delete;
+};
+
+
+#endif  // CIELCHTransformedImageCache_H_INCLUDED
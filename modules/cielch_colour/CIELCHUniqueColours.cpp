@@ -0,0 +1,243 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+namespace
+{
+    /** An open addressing hash set of premultiplied pixel values, with linear probing. The values
+    are kept in the order they were added, so that they can be converted like a line of pixels.
+    */
+    class ColourSet
+    {
+    public:
+        explicit ColourSet(int maxNumColours)
+            : maxColours(maxNumColours),
+              numSlots(nextPowerOfTwo(maxNumColours * 2)),
+              slots((size_t) numSlots, true),
+              colours((size_t) maxNumColours)
+        {
+            // the hash uses the top bits of the product, so that similar colours are spread out
+            while ((1 << (32 - shift)) < numSlots)
+                --shift;
+        }
+
+        /** Adds a colour if it isn't in the set yet.
+        @returns false if the set is full
+        */
+        bool add(PixelARGB colour) noexcept
+        {
+            const uint32 key = colour.getNativeARGB();
+
+            for (int i = getSlot(key);; i = (i + 1) & (numSlots - 1))
+            {
+                const int slot = slots[i];
+
+                if (slot == 0)
+                {
+                    if (numColours == maxColours)
+                        return false;
+
+                    colours[numColours++] = colour;
+                    slots[i] = numColours;
+                    return true;
+                }
+
+                if (colours[slot - 1].getNativeARGB() == key)
+                    return true;
+            }
+        }
+
+        /** Returns the index of a colour, or -1 if it isn't in the set */
+        int indexOf(uint32 key) const noexcept
+        {
+            for (int i = getSlot(key);; i = (i + 1) & (numSlots - 1))
+            {
+                const int slot = slots[i];
+
+                if (slot == 0)
+                    return -1;
+
+                if (colours[slot - 1].getNativeARGB() == key)
+                    return slot - 1;
+            }
+        }
+
+        int size() const noexcept                       { return numColours; }
+        const PixelARGB* getColours() const noexcept    { return colours; }
+
+    private:
+
+        int getSlot(uint32 key) const noexcept          { return (int) ((key * 0x9e3779b1u) >> shift); }
+
+        const int maxColours, numSlots;
+        int shift = 32, numColours = 0;
+
+        /** The index + 1 of the colour in each slot, 0 for an empty slot */
+        HeapBlock<int> slots;
+        HeapBlock<PixelARGB> colours;
+
+        JUCE_DECLARE_NON_COPYABLE(ColourSet)
+    };
+
+    template <class PixelType>
+    bool collectColours(const Image::BitmapData& data, ColourSet& set) noexcept
+    {
+        for (int y = 0; y < data.height; ++y)
+        {
+            const uint8* src = data.getLinePointer(y);
+            uint32 previous = 0;
+
+            for (int x = 0; x < data.width; ++x)
+            {
+                PixelARGB p;
+                p.set(*reinterpret_cast<const PixelType*>(src));
+                src += data.pixelStride;
+
+                // a run of the same colour is looked up only once
+                if (x > 0 && p.getNativeARGB() == previous)
+                    continue;
+
+                if (!set.add(p))
+                    return false;
+
+                previous = p.getNativeARGB();
+            }
+        }
+
+        return true;
+    }
+
+    template <class PixelType>
+    void remapLines(const Image::BitmapData& data, const ColourSet& set, const PixelARGB* results,
+                    int startRow, int endRow) noexcept
+    {
+        for (int y = startRow; y < endRow; ++y)
+        {
+            uint8* dest = data.getLinePointer(y);
+            uint32 previous = 0;
+            int index = -1;
+
+            for (int x = 0; x < data.width; ++x)
+            {
+                PixelType* pixel = reinterpret_cast<PixelType*>(dest);
+                dest += data.pixelStride;
+
+                PixelARGB p;
+                p.set(*pixel);
+
+                if (x == 0 || p.getNativeARGB() != previous)
+                {
+                    previous = p.getNativeARGB();
+                    index = set.indexOf(previous);
+                }
+
+                // every colour of the image is in the set, unless the image changed since it was collected
+                jassert(index >= 0);
+
+                if (index >= 0)
+                    pixel->set(results[index]);
+            }
+        }
+    }
+}
+
+//==============================================================================
+bool CIELCHUniqueColours::applyIfFewColours(Image& image, const PixelFunction& function, int maxColours)
+{
+    if (!image.isValid() || image.getFormat() == Image::SingleChannel)
+        return false;
+
+    // with more than one colour in four pixels, collecting the colours saves too little
+    maxColours = (int) jmin((int64) maxColours, (int64) image.getWidth() * image.getHeight() / 4);
+
+    if (maxColours < 1)
+        return false;
+
+    const Image::BitmapData data(image, Image::BitmapData::readWrite);
+    ColourSet set(maxColours);
+    bool fewColours = false;
+
+    switch (data.pixelFormat)
+    {
+        case Image::ARGB:           fewColours = collectColours<PixelARGB>(data, set); break;
+        case Image::RGB:            fewColours = collectColours<PixelRGB>(data, set); break;
+        case Image::SingleChannel:
+        case Image::UnknownFormat:
+        default:                    jassertfalse; break;
+    }
+
+    if (!fewColours)
+        return false;
+
+    // the colours are premultiplied like the image, the function expects them non premultiplied
+    const int numColours = set.size();
+    HeapBlock<PixelARGB> results((size_t) numColours);
+    memcpy(results, set.getColours(), (size_t) numColours * sizeof(PixelARGB));
+
+    CIELCHImageLine::unpremultiply(results, numColours);
+    function(results, numColours);
+    CIELCHImageLine::premultiply(results, numColours);
+
+    CIELCHParallel::forEachRowRange(data.width, data.height, [&](int startRow, int endRow, int)
+    {
+        if (data.pixelFormat == Image::ARGB)
+            remapLines<PixelARGB>(data, set, results, startRow, endRow);
+        else
+            remapLines<PixelRGB>(data, set, results, startRow, endRow);
+    });
+
+    return true;
+}
+
+void CIELCHUniqueColours::applyTo(Image& image, const PixelFunction& function, int maxColours)
+{
+    if (applyIfFewColours(image, function, maxColours))
+        return;
+
+    if (!image.isValid() || image.getFormat() == Image::SingleChannel)
+        return;
+
+    const Image::BitmapData data(image, Image::BitmapData::readWrite);
+
+    CIELCHParallel::forEachRowRange(data.width, data.height, [&](int startRow, int endRow, int)
+    {
+        HeapBlock<PixelARGB> pixels((size_t) data.width);
+
+        for (int y = startRow; y < endRow; ++y)
+        {
+            CIELCHImageLine::read(data, y, pixels);
+            function(pixels, data.width);
+            CIELCHImageLine::write(data, y, pixels);
+        }
+    });
+}
@@ -0,0 +1,100 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+#ifndef CIELCHUniqueColours_H_INCLUDED
+#define CIELCHUniqueColours_H_INCLUDED
+
+//==============================================================================
+/**
+Applies a colour operation to an image by converting each distinct colour only once.
+
+Flat UI artwork, icons and screenshots often contain only a few thousand distinct colours across
+millions of pixels. For such images it is much cheaper to collect the distinct pixel values first,
+send only those through the CIE LCH conversions, and then replace every pixel with the result for
+its value.
+
+The distinct values are collected in an open addressing hash set, and runs of identical
+neighbouring pixels are looked up only once. As soon as the image turns out to contain more than
+the maximum number of colours, the collection stops and the operation is applied to every pixel
+(the dense path). The maximum is also limited to a quarter of the number of pixels, so that small
+images and photos go the dense path after a short scan.
+
+The operation must only depend on the colour of a pixel, not on its position or neighbours. Like
+the line conversions it receives non premultiplied pixels, and it may change the alpha.
+On the dense path it is called once per line, from several threads at once.
+
+CIELabPlaneTransform::applyTo and CIELCHToneCurve::applyTo use this class automatically.
+
+Here an example on how to use the class:
+@code
+const CIELCHConverter converter(CIELCHPrecision::fast);
+
+CIELCHUniqueColours::applyTo(img, [&] (PixelARGB* pixels, int numPixels)
+{
+    HeapBlock<float> L((size_t) numPixels), C((size_t) numPixels), H((size_t) numPixels);
+    converter.RGBtoCIELCH(pixels, L, C, H, numPixels);
+    FloatVectorOperations::multiply(C, 0.5f, numPixels);
+    converter.CIELCHtoRGB(L, C, H, pixels, numPixels);
+});
+@endcode
+*/
+class CIELCHUniqueColours
+{
+public:
+
+    /** Converts numPixels non premultiplied pixels in place */
+    typedef std::function<void(PixelARGB* pixels, int numPixels)> PixelFunction;
+
+    enum { defaultMaxColours = 16384 };
+
+    /** Applies the function to every distinct colour of the image and replaces the pixels with the
+    results, if the image contains at most maxColours distinct colours.
+    @returns false, without changing the image, if it contains more colours (or is a
+             SingleChannel image). The caller can then use its own dense path.
+    */
+    static bool applyIfFewColours(Image& image, const PixelFunction& function,
+                                  int maxColours = defaultMaxColours);
+
+    /** Applies the function to all pixels of the image: like applyIfFewColours if the image has few
+    enough colours, and otherwise line by line on all CPU cores.
+    */
+    static void applyTo(Image& image, const PixelFunction& function,
+                        int maxColours = defaultMaxColours);
+
+private:
+
+    CIELCHUniqueColours() = delete;
+};
+
+
+#endif  // CIELCHUniqueColours_H_INCLUDED
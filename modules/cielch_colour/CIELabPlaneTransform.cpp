@@ -0,0 +1,132 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+const float CIELabPlaneTransform::maxChroma = 134.0f;
+
+CIELabPlaneTransform::CIELabPlaneTransform() noexcept
+    : m00(1.0f), m01(0.0f), m10(0.0f), m11(1.0f)
+{
+}
+
+CIELabPlaneTransform::CIELabPlaneTransform(float a00, float a01, float a10, float a11) noexcept
+    : m00(a00), m01(a01), m10(a10), m11(a11)
+{
+}
+
+CIELabPlaneTransform CIELabPlaneTransform::hueRotation(float amountToRotate) noexcept
+{
+    //the hue is in the range 0...1, see CIELCHColour::CIELCHtoRGB
+    const float angle = amountToRotate * 2.0f * float_Pi;
+    const float c = std::cos(angle);
+    const float s = std::sin(angle);
+
+    return CIELabPlaneTransform(c, -s, s, c);
+}
+
+CIELabPlaneTransform CIELabPlaneTransform::chromaMultiplication(float multiplier) noexcept
+{
+    multiplier = jmax(0.0f, multiplier);
+    return CIELabPlaneTransform(multiplier, 0.0f, 0.0f, multiplier);
+}
+
+CIELabPlaneTransform CIELabPlaneTransform::followedBy(const CIELabPlaneTransform& other) const noexcept
+{
+    return CIELabPlaneTransform(other.m00 * m00 + other.m01 * m10,
+                                other.m00 * m01 + other.m01 * m11,
+                                other.m10 * m00 + other.m11 * m10,
+                                other.m10 * m01 + other.m11 * m11);
+}
+
+//==============================================================================
+void CIELabPlaneTransform::transformPoints(float* a, float* b, int numValues) const noexcept
+{
+    for (int i = 0; i < numValues; ++i)
+        transformPoint(a[i], b[i]);
+}
+
+CIELCHColour CIELabPlaneTransform::apply(const CIELCHColour& colour, bool& imaginary) const noexcept
+{
+    float X, Y, Z;
+    CIELCHColour::RGBtoXYZ(colour, X, Y, Z);
+    float L, a, b;
+    CIELCHColour::XYZtoCIELab(X, Y, Z, L, a, b);
+
+    transformPoint(a, b);
+
+    CIELCHColour::CIELabtoXYZ(L, a, b, X, Y, Z);
+    CIELCHColour result;
+    CIELCHColour::XYZtoRGB(X, Y, Z, result, imaginary);
+    return result.getJuceColour().withAlpha(colour.getJuceColour().getAlpha());
+}
+
+void CIELabPlaneTransform::applyTo(Image& image, CIELCHPrecision precision) const
+{
+    if (!image.isValid() || image.getFormat() == Image::SingleChannel)
+        return;
+
+    const CIELCHConverter converter(precision);
+
+    // flat artwork has few colours, so each of them is converted only once
+    const bool fewColours = CIELCHUniqueColours::applyIfFewColours(image, [&](PixelARGB* pixels, int num)
+    {
+        HeapBlock<float> L((size_t) num), a((size_t) num), b((size_t) num);
+
+        converter.RGBtoCIELab(pixels, L, a, b, num);
+        transformPoints(a, b, num);
+        converter.CIELabtoRGB(L, a, b, pixels, num);
+    });
+
+    if (fewColours)
+        return;
+
+    const Image::BitmapData data(image, Image::BitmapData::readWrite);
+
+    CIELCHParallel::forEachRowRange(data.width, data.height, [&](int startRow, int endRow, int)
+    {
+        HeapBlock<PixelARGB> pixels((size_t) data.width);
+        HeapBlock<int> positions((size_t) data.width);
+        HeapBlock<float> L((size_t) data.width), a((size_t) data.width), b((size_t) data.width);
+
+        for (int y = startRow; y < endRow; ++y)
+        {
+            // the alpha doesn't change, so fully transparent pixels are skipped
+            const int num = CIELCHImageLine::readVisible(data, y, pixels, positions);
+
+            converter.RGBtoCIELab(pixels, L, a, b, num);
+            transformPoints(a, b, num);
+            converter.CIELabtoRGB(L, a, b, pixels, num);
+            CIELCHImageLine::writeVisible(data, y, pixels, positions, num);
+        }
+    });
+}
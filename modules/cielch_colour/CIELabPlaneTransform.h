@@ -0,0 +1,127 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+#ifndef CIELabPlaneTransform_H_INCLUDED
+#define CIELabPlaneTransform_H_INCLUDED
+
+//==============================================================================
+/**
+A hue rotation and/or chroma multiplication, which works directly in the CIE Lab a-b plane.
+
+Rotating the CIE hue is a rotation of (a, b) around the origin, and multiplying the CIE chroma
+is a uniform scaling of (a, b). So both can be done with a 2x2 matrix, which is calculated once
+when the transform is created. Compared to CIELCHColour::withRotatedCIEHue and
+CIELCHColour::withMultipliedCIEChroma this saves the atan2, sqrt, cos and sin calls of the
+conversion to and from CIE LCH for every colour. The results are the same, apart from rounding.
+
+Here an example on how to use the class:
+@code
+const CIELabPlaneTransform shift = CIELabPlaneTransform::hueRotation(0.25f)
+                                       .followedBy(CIELabPlaneTransform::chromaMultiplication(0.5f));
+shift.applyTo(img);
+
+bool imaginary;
+CIELCHColour newColour = shift.apply(Colours::yellow, imaginary);
+@endcode
+*/
+class CIELabPlaneTransform
+{
+public:
+
+    /** Creates an identity transform. */
+    CIELabPlaneTransform() noexcept;
+
+    /** Creates a transform which rotates the CIE hue.
+    The hue is in the range 0...1, see CIELCHColour::withRotatedCIEHue.
+    */
+    static CIELabPlaneTransform hueRotation(float amountToRotate) noexcept;
+
+    /** Creates a transform which multiplies the CIE chroma/saturation.
+    Negative multipliers are treated as zero, see CIELCHColour::withMultipliedCIEChroma.
+    */
+    static CIELabPlaneTransform chromaMultiplication(float multiplier) noexcept;
+
+    /** Returns a transform which applies this transform and then the other one. */
+    CIELabPlaneTransform followedBy(const CIELabPlaneTransform& other) const noexcept;
+
+    //==============================================================================
+    /** Transforms a single pair of CIE Lab a and b values.
+    Like CIELCHColour::CIELCHtoRGB, the resulting chroma is limited to 134.
+    */
+    void transformPoint(float& a, float& b) const noexcept
+    {
+        const float newA = m00 * a + m01 * b;
+        const float newB = m10 * a + m11 * b;
+        a = newA;
+        b = newB;
+
+        const float chromaSquared = a * a + b * b;
+
+        if (chromaSquared > maxChroma * maxChroma)
+        {
+            const float scale = maxChroma / std::sqrt(chromaSquared);
+            a *= scale;
+            b *= scale;
+        }
+    }
+
+    /** Transforms numValues pairs of CIE Lab a and b values in place. */
+    void transformPoints(float* a, float* b, int numValues) const noexcept;
+
+    /** Returns a transformed copy of a colour.
+    If the returned colour is an imaginary colour, then the "imaginary" parameter is set to true.
+    @see CIELCHColour::fromCIELCH for a better explanation on imaginary.
+    */
+    CIELCHColour apply(const CIELCHColour& colour, bool& imaginary) const noexcept;
+
+    /** Transforms all pixels of an image in place.
+    The work is split over all CPU cores. Images with few distinct colours convert each colour only
+    once, see CIELCHUniqueColours.
+    @param image = the image to transform
+    @param precision = the precision of the colour conversions, see CIELCHPrecision. By default
+                       the one of CIELCHConverter::getDefaultPrecision().
+    */
+    void applyTo(Image& image, CIELCHPrecision precision = CIELCHConverter::getDefaultPrecision()) const;
+
+private:
+
+    CIELabPlaneTransform(float a00, float a01, float a10, float a11) noexcept;
+
+    static const float maxChroma;
+
+    float m00, m01, m10, m11;
+};
+
+
+#endif  // CIELabPlaneTransform_H_INCLUDED
@@ -0,0 +1,71 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+
+#ifdef CIELCH_COLOUR_H_INCLUDED
+ /* When you add this cpp file to your project, you mustn't include it in a file where you've
+    already included any other headers - just put it inside a file on its own, possibly with your config
+    flags preceding it, but don't include anything else. That also includes avoiding any automatic prefix
+    header files that the compiler may be using.
+ */
+ #error "Incorrect use of JUCE cpp file"
+#endif
+
+#include "cielch_colour.h"
+
+namespace juce
+{
+    #include "CIELCHInstrumentation.cpp"
+    #include "CIELCHConversion.cpp"
+    #include "CIELCHColour.cpp"
+    #include "CIELCHColourCache.cpp"
+    #include "CIELCHKernels.cpp"
+    #include "CIELCHImageLine.cpp"
+    #include "CIELCHParallel.cpp"
+    #include "CIELCHUniqueColours.cpp"
+    #include "CIELabPlaneTransform.cpp"
+    #include "CIELCHImageStatistics.cpp"
+    #include "CIELCHColourMap.cpp"
+    #include "CIELCHToneCurve.cpp"
+    #include "CIELCHBlend.cpp"
+    #include "CIELCHImageBuffer.cpp"
+    #include "CIELCHImageJobs.cpp"
+    #include "CIELCHTransformedImageCache.cpp"
+
+   #if JUCE_MODULE_AVAILABLE_juce_gui_basics
+    #include "CIELCHImageEffectFilter.cpp"
+    #include "CIELCHColourPicker.cpp"
+    #include "CIELCHTheme.cpp"
+   #endif
+}
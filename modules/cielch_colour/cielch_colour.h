@@ -0,0 +1,167 @@
+/*
+==============================================================================
+
+This file is part of the CIELCH Colour JUCE module
+Copyright 2016 by Alatar79
+
+The CIELCH JUCE module is hosted on github: https://github.com/Alatar79/JUCE-CIELCH
+
+------------------------------------------------------------------------------
+
+The CIELCH Colour JUCE module is provided under the terms of The MIT License (MIT):
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+==============================================================================
+*/
+
+
+/*******************************************************************************
+ The block below describes the properties of this module, and is read by
+ the Projucer to automatically generate project code that uses it.
+ For details about the syntax and how to create or use a module, see the
+ JUCE Module Format.txt file.
+
+
+ BEGIN_JUCE_MODULE_DECLARATION
+
+  ID:               cielch_colour
+  vendor:           Alatar79
+  version:          1.0.0
+  name:             CIELCH Colour
+  description:      Colours, colour maps, tone curves, blending and image processing in the CIE LCH colour space.
+  website:          https://github.com/Alatar79/JUCE-CIELCH
+  license:          MIT
+
+  dependencies:     juce_core, juce_graphics
+
+ END_JUCE_MODULE_DECLARATION
+
+*******************************************************************************/
+
+
+#ifndef CIELCH_COLOUR_H_INCLUDED
+#define CIELCH_COLOUR_H_INCLUDED
+
+#include <juce_core/juce_core.h>
+#include <juce_graphics/juce_graphics.h>
+
+#if JUCE_MODULE_AVAILABLE_juce_gui_basics
+ #include <juce_gui_basics/juce_gui_basics.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+//==============================================================================
+/** Config: CIELCH_ENABLE_INSTRUMENTATION
+    Counts the calls of the CIELCHColour conversions and the imaginary colours they produce.
+    See CIELCHInstrumentation.
+*/
+#ifndef CIELCH_ENABLE_INSTRUMENTATION
+ #define CIELCH_ENABLE_INSTRUMENTATION 0
+#endif
+
+/** Config: CIELCH_ENABLE_STAGE_TIMING
+    Also samples the time spent in each stage of the CIELCHColour conversions.
+    This implies CIELCH_ENABLE_INSTRUMENTATION.
+*/
+#ifndef CIELCH_ENABLE_STAGE_TIMING
+ #define CIELCH_ENABLE_STAGE_TIMING 0
+#endif
+
+#if CIELCH_ENABLE_STAGE_TIMING && ! CIELCH_ENABLE_INSTRUMENTATION
+ #undef CIELCH_ENABLE_INSTRUMENTATION
+ #define CIELCH_ENABLE_INSTRUMENTATION 1
+#endif
+
+/** Config: CIELCH_ENABLE_COLOUR_CACHE
+    Makes CIELCHColour::getCIELCH, and the functions which use it, look up the CIE LCH values in a
+    small thread-local cache first. See CIELCHColourCache.
+*/
+#ifndef CIELCH_ENABLE_COLOUR_CACHE
+ #define CIELCH_ENABLE_COLOUR_CACHE 0
+#endif
+
+/** Config: CIELCH_DEFAULT_PRECISION
+    The CIELCHPrecision of the CIELCHColour functions and the image operations when they are
+    called without one: 0 for exact, 1 for fast and 2 for fastest. It can be changed at run time
+    with CIELCHConverter::setDefaultPrecision.
+*/
+#ifndef CIELCH_DEFAULT_PRECISION
+ #define CIELCH_DEFAULT_PRECISION 0
+#endif
+
+/** Config: CIELCH_CONSTEXPR_TABLES
+    If this is enabled, the lookup tables of CIELCHConversionTables are calculated by the compiler
+    and stored as read-only data, so they cost nothing when a program or plug-in is loaded.
+    Otherwise they are calculated the first time they are used.
+    This needs C++14 constexpr, and a compiler allowing enough steps in a constant expression for
+    tables of 4097 entries and for the max chroma grid (about 8 and 16 million operations in GCC's
+    count). So it defaults to 1 for GCC only. Clang and MSVC need their limits raised with
+    -fconstexpr-steps and /constexpr:steps before enabling it.
+*/
+#ifndef CIELCH_CONSTEXPR_TABLES
+ #if __cpp_constexpr >= 201304 && defined (__GNUC__) && ! defined (__clang__)
+  #define CIELCH_CONSTEXPR_TABLES 1
+ #else
+  #define CIELCH_CONSTEXPR_TABLES 0
+ #endif
+#endif
+
+//==============================================================================
+namespace juce
+{
+    #include "CIELCHFastMath.h"
+    #include "CIELCHInstrumentation.h"
+    #include "CIELCHConversion.h"
+    #include "CIELCHColourCache.h"
+    #include "CIELCHColour.h"
+    #include "CIELCHKernels.h"
+    #include "CIELCHImageLine.h"
+    #include "CIELCHParallel.h"
+    #include "CIELCHUniqueColours.h"
+    #include "CIELabPlaneTransform.h"
+    #include "CIELCHImageStatistics.h"
+    #include "CIELCHColourMap.h"
+    #include "CIELCHToneCurve.h"
+    #include "CIELCHBlend.h"
+    #include "CIELCHImageBuffer.h"
+    #include "CIELCHImageJobs.h"
+    #include "CIELCHTransformedImageCache.h"
+
+   #if JUCE_MODULE_AVAILABLE_juce_gui_basics
+    #include "CIELCHImageEffectFilter.h"
+    #include "CIELCHColourPicker.h"
+    #include "CIELCHTheme.h"
+   #endif
+}
+
+
+#endif  // CIELCH_COLOUR_H_INCLUDED